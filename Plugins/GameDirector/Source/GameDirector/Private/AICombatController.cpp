@@ -1,11 +1,14 @@
 #include "AICombatController.h"
 
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/BlackboardData.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Float.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Int.h"
+#include "GameDirectorStats.h"
 #include "GameDirectorSubsystem.h"
 
 AAICombatController::AAICombatController()
 {
-
     //{"schema": "gda.fps.output.v1", "intent": "tune_difficulty", "reason": "Easing pressure due to fast player deaths.", "tool_calls": [{"name": "AdjustAIDifficulty", "args": {"aim_spread_level": 2, "aim_spread_fine": 0.05, "reaction_level": 1, "aggression_level": 1, "peek_level": 1, "duration_s": 60}}]}
     aggression_level= TEXT("AggressionLevel");
     reaction_level= TEXT("ReactionLevel");
@@ -27,16 +30,32 @@ AAICombatController::AAICombatController()
 void AAICombatController::BeginPlay()
 {
     Super::BeginPlay();
-    RegisterWithSubsystem();
-    PushToBlackboard();
+
+    // Spread the checks so controllers spawned together do not all sync on the same frame.
+    TimeUntilDifficultySync = FMath::FRandRange(0.0f, DifficultySyncInterval);
+
+    if (!SyncDifficulty())
+    {
+        PushToBlackboard();
+    }
 }
 
 void AAICombatController::OnPossess(APawn* InPawn)
 {
     Super::OnPossess(InPawn);
     CachedDifficulty = DefaultDifficulty;
-    PushToBlackboard();
-    RegisterWithSubsystem();
+    AppliedDifficultyVersion = INDEX_NONE;
+
+    // The behavior tree may have swapped the blackboard during possession.
+    if (const UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+    {
+        ResolveBlackboardKeys(*BlackboardComp);
+    }
+
+    if (!SyncDifficulty())
+    {
+        PushToBlackboard();
+    }
 }
 
 void AAICombatController::OnUnPossess()
@@ -47,10 +66,29 @@ void AAICombatController::OnUnPossess()
 
 void AAICombatController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    UnregisterFromSubsystem();
+    CachedSubsystem.Reset();
+    DifficultyTargetHandles.Reset();
     Super::EndPlay(EndPlayReason);
 }
 
+void AAICombatController::Tick(float DeltaSeconds)
+{
+    FGameDirectorAITimeScope AITimeScope(this);
+
+    Super::Tick(DeltaSeconds);
+
+    // The controller tick also drives focus and control rotation, so only the version check is throttled.
+    if (DifficultySyncInterval > 0.0f)
+    {
+        TimeUntilDifficultySync -= DeltaSeconds;
+        if (TimeUntilDifficultySync <= 0.0f)
+        {
+            TimeUntilDifficultySync += DifficultySyncInterval;
+            SyncDifficulty();
+        }
+    }
+}
+
 void AAICombatController::AdjustDifficulty(const FAIDifficulty& InDiff)
 {
     CachedDifficulty = InDiff;
@@ -60,63 +98,177 @@ void AAICombatController::AdjustDifficulty(const FAIDifficulty& InDiff)
 
 void AAICombatController::ResetDifficulty()
 {
-    CachedDifficulty = DefaultDifficulty;
+    // Defaults are tuned per controller (bosses run hotter), so they are capped here rather than when published.
+    const UGameDirectorSubsystem* Subsystem = GetSubsystem();
+    CachedDifficulty = Subsystem ? Subsystem->CapDifficulty(DefaultDifficulty) : DefaultDifficulty;
     UE_LOG(LogGameDirector, Verbose, TEXT("%s resetting AI difficulty to defaults: %s"), *GetName(), *CachedDifficulty.ToString());
     PushToBlackboard();
 }
 
 void AAICombatController::PushToBlackboard()
 {
-    if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+    UBlackboardComponent* BlackboardComp = GetBlackboardComponent();
+    if (!BlackboardComp || !BlackboardComp->GetBlackboardAsset())
+    {
+        return;
+    }
+
+    if (BlackboardKeysAsset.Get() != BlackboardComp->GetBlackboardAsset())
     {
-        BlackboardComp->SetValueAsInt(aggression_level, (CachedDifficulty.AggressionLevel));
-        BlackboardComp->SetValueAsInt(reaction_level, (CachedDifficulty.ReactionLevel));
-        BlackboardComp->SetValueAsInt(peek_level, (CachedDifficulty.PeekLevel));
-		BlackboardComp->SetValueAsFloat(aim_spread_fine, (CachedDifficulty.AimSpreadFine));
-		BlackboardComp->SetValueAsInt(aim_spread_level, (CachedDifficulty.AimSpreadLevel));
-		BlackboardComp->SetValueAsInt(duration_s, (CachedDifficulty.DurationS));
+        ResolveBlackboardKeys(*BlackboardComp);
+    }
+
+    const FAIDifficulty& Diff = CachedDifficulty;
+    const FAIDifficulty* Pushed = PushedDifficulty.GetPtrOrNull();
 
+    const bool bAggression = !Pushed || Pushed->AggressionLevel != Diff.AggressionLevel;
+    const bool bReaction = !Pushed || Pushed->ReactionLevel != Diff.ReactionLevel;
+    const bool bPeek = !Pushed || Pushed->PeekLevel != Diff.PeekLevel;
+    const bool bAimFine = !Pushed || Pushed->AimSpreadFine != Diff.AimSpreadFine;
+    const bool bAimLevel = !Pushed || Pushed->AimSpreadLevel != Diff.AimSpreadLevel;
+    const bool bDuration = !Pushed || Pushed->DurationS != Diff.DurationS;
+
+    if (!(bAggression || bReaction || bPeek || bAimFine || bAimLevel || bDuration))
+    {
+        return;
+    }
+
+    // Queue observer notifications so decorators re-evaluate once for the batch instead of after every key.
+    BlackboardComp->PauseObserverNotifications();
+
+    if (bAggression)
+    {
+        BlackboardComp->SetValue<UBlackboardKeyType_Int>(BlackboardKeys.AggressionLevel, Diff.AggressionLevel);
+    }
+    if (bReaction)
+    {
+        BlackboardComp->SetValue<UBlackboardKeyType_Int>(BlackboardKeys.ReactionLevel, Diff.ReactionLevel);
     }
+    if (bPeek)
+    {
+        BlackboardComp->SetValue<UBlackboardKeyType_Int>(BlackboardKeys.PeekLevel, Diff.PeekLevel);
+    }
+    if (bAimFine)
+    {
+        BlackboardComp->SetValue<UBlackboardKeyType_Float>(BlackboardKeys.AimSpreadFine, Diff.AimSpreadFine);
+    }
+    if (bAimLevel)
+    {
+        BlackboardComp->SetValue<UBlackboardKeyType_Int>(BlackboardKeys.AimSpreadLevel, Diff.AimSpreadLevel);
+    }
+    if (bDuration)
+    {
+        BlackboardComp->SetValue<UBlackboardKeyType_Int>(BlackboardKeys.DurationS, Diff.DurationS);
+    }
+
+    BlackboardComp->ResumeObserverNotifications(true);
+
+    PushedDifficulty = Diff;
 }
 
-void AAICombatController::OnSubsystemDifficultyChanged(const FAIDifficulty& InDiff)
+void AAICombatController::ResolveBlackboardKeys(const UBlackboardComponent& BlackboardComp)
 {
-    UE_LOG(LogGameDirector, Log, TEXT("[%s] Received difficulty update: %s"),
-        *GetName(),
-        *InDiff.ToString());
-    AdjustDifficulty(InDiff);
+    BlackboardKeys.AggressionLevel = BlackboardComp.GetKeyID(aggression_level);
+    BlackboardKeys.ReactionLevel = BlackboardComp.GetKeyID(reaction_level);
+    BlackboardKeys.PeekLevel = BlackboardComp.GetKeyID(peek_level);
+    BlackboardKeys.AimSpreadFine = BlackboardComp.GetKeyID(aim_spread_fine);
+    BlackboardKeys.AimSpreadLevel = BlackboardComp.GetKeyID(aim_spread_level);
+    BlackboardKeys.DurationS = BlackboardComp.GetKeyID(duration_s);
+
+    BlackboardKeysAsset = BlackboardComp.GetBlackboardAsset();
+    PushedDifficulty.Reset();
 }
 
-void AAICombatController::RegisterWithSubsystem()
+bool AAICombatController::SyncDifficulty()
 {
-    if (CachedSubsystem.IsValid())
+    UGameDirectorSubsystem* Subsystem = GetSubsystem();
+    if (!Subsystem)
     {
-        return;
+        return false;
+    }
+
+    if (DifficultyTargetHandles.IsEmpty())
+    {
+        if (bFollowGlobalDifficulty)
+        {
+            DifficultyTargetHandles.Add(UGameDirectorSubsystem::GlobalDifficultyTarget);
+        }
+
+        for (const FName Selector : {
+            UGameDirectorSubsystem::MakeDifficultyTargetSelector(TEXT("archetype"), DifficultyArchetype),
+            UGameDirectorSubsystem::MakeDifficultyTargetSelector(TEXT("squad"), DifficultySquad),
+            UGameDirectorSubsystem::MakeDifficultyTargetSelector(TEXT("region"), DifficultyRegion) })
+        {
+            const int32 Handle = Selector.IsNone() ? INDEX_NONE : Subsystem->FindOrAddDifficultyTarget(Selector);
+            if (Handle != INDEX_NONE)
+            {
+                DifficultyTargetHandles.Add(Handle);
+            }
+        }
     }
 
-    if (UGameInstance* GameInstance = GetGameInstance())
+    const FAIDifficultySnapshot* Latest = nullptr;
+    for (const int32 Handle : DifficultyTargetHandles)
     {
-        if (UGameDirectorSubsystem* Subsystem = GameInstance->GetSubsystem<UGameDirectorSubsystem>())
+        const FAIDifficultySnapshot& Snapshot = Subsystem->GetTargetSnapshot(Handle);
+        if (Snapshot.Version > 0 && (!Latest || Snapshot.Version > Latest->Version))
         {
-            Subsystem->OnDifficultyChanged.AddDynamic(this, &AAICombatController::OnSubsystemDifficultyChanged);
-            CachedSubsystem = Subsystem;
-            AdjustDifficulty(Subsystem->GetCurrentDifficulty());
+            Latest = &Snapshot;
         }
     }
+
+    // Capped snapshots are republished with a new version when the caps change; the defaults need the caps version.
+    const int32 Version = Latest ? Latest->Version : 0;
+    const int32 LoadCapsVersion = Subsystem->GetLoadCapsVersion();
+    if (Version == AppliedDifficultyVersion && (Latest || LoadCapsVersion == AppliedLoadCapsVersion))
+    {
+        return false;
+    }
+
+    AppliedDifficultyVersion = Version;
+    AppliedLoadCapsVersion = LoadCapsVersion;
+    if (Latest)
+    {
+        AdjustDifficulty(Latest->Difficulty);
+    }
+    else
+    {
+        ResetDifficulty();
+    }
+    return true;
 }
 
-void AAICombatController::UnregisterFromSubsystem()
+void AAICombatController::SetDifficultySquad(FName InSquad)
 {
-    if (UGameDirectorSubsystem* Subsystem = CachedSubsystem.Get())
+    DifficultySquad = InSquad;
+    DifficultyTargetHandles.Reset();
+    SyncDifficulty();
+}
+
+void AAICombatController::SetDifficultyRegion(FName InRegion)
+{
+    DifficultyRegion = InRegion;
+    DifficultyTargetHandles.Reset();
+    SyncDifficulty();
+}
+
+UGameDirectorSubsystem* AAICombatController::GetSubsystem()
+{
+    if (!CachedSubsystem.IsValid())
     {
-        Subsystem->OnDifficultyChanged.RemoveDynamic(this, &AAICombatController::OnSubsystemDifficultyChanged);
+        if (UGameInstance* GameInstance = GetGameInstance())
+        {
+            CachedSubsystem = GameInstance->GetSubsystem<UGameDirectorSubsystem>();
+        }
     }
 
-    CachedSubsystem.Reset();
+    return CachedSubsystem.Get();
 }
 
 AAIEnemyController::AAIEnemyController()
 {
+    DifficultyArchetype = TEXT("grunt");
+
     DefaultDifficulty.AimSpreadLevel = 1;
     DefaultDifficulty.AimSpreadFine = 0.02f;
     DefaultDifficulty.ReactionLevel = 1;
@@ -129,6 +281,10 @@ AAIEnemyController::AAIEnemyController()
 
 ABossAIController::ABossAIController()
 {
+    // Bosses keep their tuned defaults unless the director addresses archetype:boss directly.
+    DifficultyArchetype = TEXT("boss");
+    bFollowGlobalDifficulty = false;
+
     DefaultDifficulty.AimSpreadLevel = 3;
     DefaultDifficulty.AimSpreadFine = -0.05f;
     DefaultDifficulty.ReactionLevel = 3;
@@ -0,0 +1,32 @@
+#include "BTService_GameDirectorDifficulty.h"
+
+#include "AICombatController.h"
+#include "BehaviorTree/BehaviorTreeComponent.h"
+
+UBTService_GameDirectorDifficulty::UBTService_GameDirectorDifficulty()
+{
+    NodeName = TEXT("Sync GameDirector Difficulty");
+    Interval = 0.5f;
+    RandomDeviation = 0.1f;
+    bNotifyBecomeRelevant = true;
+}
+
+void UBTService_GameDirectorDifficulty::OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+    Super::OnBecomeRelevant(OwnerComp, NodeMemory);
+    Sync(OwnerComp);
+}
+
+void UBTService_GameDirectorDifficulty::TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+    Super::TickNode(OwnerComp, NodeMemory, DeltaSeconds);
+    Sync(OwnerComp);
+}
+
+void UBTService_GameDirectorDifficulty::Sync(UBehaviorTreeComponent& OwnerComp)
+{
+    if (AAICombatController* Controller = Cast<AAICombatController>(OwnerComp.GetAIOwner()))
+    {
+        Controller->SyncDifficulty();
+    }
+}
@@ -1,11 +1,18 @@
 #include "EnemyCharacter.h"
 
 #include "DrawDebugHelpers.h"
-#include "Engine/Engine.h"
-#include "TimerManager.h"
+#include "GameDirectorCombatScheduler.h"
+#include "GameDirectorDifficultyBlender.h"
+#include "GameDirectorEnemyRegistry.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogEnemyCharacter, Log, All);
 
+static TAutoConsoleVariable<bool> CVarGameDirectorDrawShots(
+    TEXT("GameDirector.DrawShots"),
+    false,
+    TEXT("Draw a debug line for every resolved AEnemyCharacter shot (red on hit, yellow on miss)."));
+
 namespace
 {
     constexpr float kMinPeekInterval = 0.1f;
@@ -24,21 +31,66 @@ AEnemyCharacter::AEnemyCharacter()
     bIsPeeking = false;
     bIsShooting = false;
     ShotsFiredInBurst = 0;
+    CombatSlot = INDEX_NONE;
 }
 
 void AEnemyCharacter::BeginPlay()
 {
     Super::BeginPlay();
 
-    RefreshPeekTimer();
+    if (UGameDirectorEnemyRegistry* Registry = UGameDirectorEnemyRegistry::Get(this))
+    {
+        Registry->RegisterEnemy(this);
+    }
+
+    if (UGameDirectorDifficultyBlender* Blender = UGameDirectorDifficultyBlender::Get(this))
+    {
+        FGameDirectorEnemyParams Params;
+        Params.ReactionDelay = ReactionDelay;
+        Params.AimSpread = AimSpread;
+        Params.FireRate = FireRate;
+        Params.BurstCount = static_cast<float>(BurstCount);
+        Params.PeekInterval = PeekInterval;
+        Blender->RegisterEnemy(this, Params);
+    }
+
+    if (UGameDirectorCombatScheduler* Scheduler = UGameDirectorCombatScheduler::Get(this))
+    {
+        CombatSlot = Scheduler->RegisterEnemy(this);
+    }
+
+    if (UGameDirectorSignificanceManager* Significance = UGameDirectorSignificanceManager::Get(this))
+    {
+        Significance->RegisterActor(this);
+    }
+
+    SchedulePeekToggle();
 }
 
 void AEnemyCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     Super::EndPlay(EndPlayReason);
 
-    GetWorldTimerManager().ClearTimer(FireTimerHandle);
-    GetWorldTimerManager().ClearTimer(PeekTimerHandle);
+    if (UGameDirectorEnemyRegistry* Registry = UGameDirectorEnemyRegistry::Get(this))
+    {
+        Registry->UnregisterEnemy(this);
+    }
+
+    if (UGameDirectorDifficultyBlender* Blender = UGameDirectorDifficultyBlender::Get(this))
+    {
+        Blender->UnregisterEnemy(this);
+    }
+
+    if (UGameDirectorSignificanceManager* Significance = UGameDirectorSignificanceManager::Get(this))
+    {
+        Significance->UnregisterActor(this);
+    }
+
+    if (UGameDirectorCombatScheduler* Scheduler = UGameDirectorCombatScheduler::Get(this))
+    {
+        Scheduler->UnregisterEnemy(CombatSlot);
+    }
+    CombatSlot = INDEX_NONE;
 }
 
 void AEnemyCharacter::StartShooting()
@@ -56,8 +108,7 @@ void AEnemyCharacter::StartShooting()
     bIsShooting = true;
     ShotsFiredInBurst = 0;
 
-    const float FireInterval = 1.0f / FireRate;
-    GetWorldTimerManager().SetTimer(FireTimerHandle, this, &AEnemyCharacter::FireOneShot, FireInterval, true, ReactionDelay);
+    ScheduleCombatEvent(EGameDirectorCombatEvent::Fire, ReactionDelay);
 }
 
 void AEnemyCharacter::StopShooting()
@@ -70,7 +121,10 @@ void AEnemyCharacter::StopShooting()
     bIsShooting = false;
     ShotsFiredInBurst = 0;
 
-    GetWorldTimerManager().ClearTimer(FireTimerHandle);
+    if (UGameDirectorCombatScheduler* Scheduler = UGameDirectorCombatScheduler::Get(this))
+    {
+        Scheduler->Cancel(CombatSlot, EGameDirectorCombatEvent::Fire);
+    }
 }
 
 void AEnemyCharacter::FireOneShot()
@@ -80,70 +134,76 @@ void AEnemyCharacter::FireOneShot()
         return;
     }
 
-    UWorld* World = GetWorld();
-    if (!World)
+    // Shots of enemies the player cannot observe only advance the burst.
+    UGameDirectorCombatScheduler* Scheduler = UGameDirectorCombatScheduler::Get(this);
+    if (Scheduler && SignificanceBudget.bTraceShots)
     {
-        return;
-    }
-
-    const FVector Start = GetActorLocation() + GetActorForwardVector() * 50.f;
-    const float AimSpreadRadians = FMath::DegreesToRadians(AimSpread);
-    const FVector ShootDirection = FMath::VRandCone(GetActorForwardVector(), AimSpreadRadians);
-    const FVector End = Start + ShootDirection * kTraceDistance;
+        const FVector Start = GetActorLocation() + GetActorForwardVector() * 50.f;
+        const float AimSpreadRadians = FMath::DegreesToRadians(AimSpread);
+        const FVector ShootDirection = FMath::VRandCone(GetActorForwardVector(), AimSpreadRadians);
+        const FVector End = Start + ShootDirection * kTraceDistance;
 
-    FHitResult Hit;
-    FCollisionQueryParams Params(SCENE_QUERY_STAT(EnemyCharacterFire), false, this);
-
-    const bool bHit = World->LineTraceSingleByChannel(Hit, Start, End, ECC_Visibility, Params);
-    const FColor DebugColor = bHit ? FColor::Red : FColor::Yellow;
-
-    DrawDebugLine(World, Start, bHit ? Hit.ImpactPoint : End, DebugColor, false, 1.0f, 0, 1.5f);
+        Scheduler->QueueShot(this, Start, End);
+    }
 
     ++ShotsFiredInBurst;
     if (ShotsFiredInBurst >= BurstCount)
     {
         ShotsFiredInBurst = 0;
-
+        ScheduleCombatEvent(EGameDirectorCombatEvent::Fire, ReactionDelay);
+    }
+    else
+    {
         const float FireInterval = (FireRate > KINDA_SMALL_NUMBER) ? (1.0f / FireRate) : 1.0f;
-        GetWorldTimerManager().ClearTimer(FireTimerHandle);
-        GetWorldTimerManager().SetTimer(FireTimerHandle, this, &AEnemyCharacter::FireOneShot, FireInterval, true, ReactionDelay);
+        ScheduleCombatEvent(EGameDirectorCombatEvent::Fire, FireInterval);
     }
 }
 
-void AEnemyCharacter::ApplyDifficulty(const FAIDifficulty& Diff)
+void AEnemyCharacter::OnShotResolved(const FVector& Start, const FVector& End, const FHitResult* Hit)
 {
-    CurrentDifficulty = Diff;
+#if ENABLE_DRAW_DEBUG
+    if (CVarGameDirectorDrawShots.GetValueOnGameThread())
+    {
+        DrawDebugLine(GetWorld(), Start, Hit ? Hit->ImpactPoint : End, Hit ? FColor::Red : FColor::Yellow, false, 1.0f, 0, 1.5f);
+    }
+#endif
+}
 
-    ReactionDelay = FMath::Clamp(1.5f - Diff.ReactionLevel * 0.25f, 0.2f, 1.5f);
-    AimSpread = FMath::Clamp(5.0f - Diff.AimSpreadLevel * 0.8f + Diff.AimSpreadFine, 0.5f, 8.0f);
-    FireRate = FMath::Clamp(1.0f + Diff.AggressionLevel * 0.5f, 1.0f, 5.0f);
-    BurstCount = FMath::Clamp(2 + Diff.AggressionLevel, 2, 8);
-    PeekInterval = FMath::Clamp(3.0f - Diff.PeekLevel * 0.4f, 0.5f, 3.0f);
+void AEnemyCharacter::OnSignificanceChanged(EGameDirectorSignificance Significance, const FGameDirectorSignificanceBudget& Budget)
+{
+    // Picked up by the next peek toggle and shot; rescheduling now would reset cadences on every bucket change.
+    SignificanceBudget = Budget;
+}
 
-    UE_LOG(LogEnemyCharacter, Log, TEXT("ApplyDifficulty: ReactionDelay=%.2f AimSpread=%.2f FireRate=%.2f BurstCount=%d PeekInterval=%.2f"), ReactionDelay, AimSpread, FireRate, BurstCount, PeekInterval);
+void AEnemyCharacter::ApplyDifficulty(const FAIDifficulty& Diff)
+{
+    CurrentDifficulty = Diff;
 
-    if (GEngine)
+    if (UGameDirectorDifficultyBlender* Blender = UGameDirectorDifficultyBlender::Get(this))
     {
-        const FString Message = FString::Printf(TEXT("AI Diff -> Reaction: %.2fs | Spread: %.2f | FireRate: %.2f | Burst: %d"), ReactionDelay, AimSpread, FireRate, BurstCount);
-        const uint64 DebugKey = reinterpret_cast<uint64>(this);
-        GEngine->AddOnScreenDebugMessage(DebugKey, 2.0f, FColor::Green, Message);
+        Blender->SetTarget(this, Diff);
     }
-
-    RefreshPeekTimer();
-
-    if (bIsShooting)
+    else
     {
-        StopShooting();
-        if (bIsPeeking)
-        {
-            StartShooting();
-        }
+        SetCombatParams(FGameDirectorDifficultyTable::Default().Evaluate(Diff));
     }
+
+    UE_LOG(LogEnemyCharacter, Verbose, TEXT("%s ApplyDifficulty: %s"), *GetName(), *Diff.ToString());
+}
+
+void AEnemyCharacter::SetCombatParams(const FGameDirectorEnemyParams& Params)
+{
+    ReactionDelay = Params.ReactionDelay;
+    AimSpread = Params.AimSpread;
+    FireRate = Params.FireRate;
+    BurstCount = FMath::RoundToInt32(Params.BurstCount);
+    PeekInterval = Params.PeekInterval;
 }
 
 void AEnemyCharacter::TogglePeek()
 {
     bIsPeeking = !bIsPeeking;
+    SchedulePeekToggle();
 
     if (bIsPeeking)
     {
@@ -168,10 +228,16 @@ void AEnemyCharacter::ExitCover()
     }
 }
 
-void AEnemyCharacter::RefreshPeekTimer()
+void AEnemyCharacter::SchedulePeekToggle()
 {
-    const float Interval = FMath::Max(PeekInterval, kMinPeekInterval);
+    const float Interval = PeekInterval * SignificanceBudget.DecisionIntervalScale;
+    ScheduleCombatEvent(EGameDirectorCombatEvent::PeekToggle, FMath::Max(Interval, kMinPeekInterval));
+}
 
-    GetWorldTimerManager().ClearTimer(PeekTimerHandle);
-    GetWorldTimerManager().SetTimer(PeekTimerHandle, this, &AEnemyCharacter::TogglePeek, Interval, true, Interval);
+void AEnemyCharacter::ScheduleCombatEvent(EGameDirectorCombatEvent Event, float DelaySeconds)
+{
+    if (UGameDirectorCombatScheduler* Scheduler = UGameDirectorCombatScheduler::Get(this))
+    {
+        Scheduler->Schedule(CombatSlot, Event, DelaySeconds);
+    }
 }
@@ -0,0 +1,626 @@
+#include "GameDirectorBenchmarkCommandlet.h"
+
+#include "GameDirectorJob.h"
+#include "GameDirectorJobQueue.h"
+#include "GameDirectorModelManager.h"
+#include "GameDirectorRecorder.h"
+#include "GameDirectorScenario.h"
+#include "GameDirectorStats.h"
+#include "GameDirectorSubsystem.h"
+#include "LlamaRunner.h"
+#include "MockLlamaRunner.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameDirectorBenchmark, Log, All);
+
+namespace
+{
+    const TCHAR* kInputSchema = TEXT("gda.fps.input.v1");
+    const TCHAR* kOutputSchema = TEXT("gda.fps.output.v1");
+
+    struct FBenchmarkSample
+    {
+        const FGameDirectorRecordEntry* Recorded = nullptr;
+        FString Response;
+        bool bValidOutput = false;
+        bool bDecisionChanged = false;
+        int32 LevelDelta = 0;
+        double QueueWaitMs = 0.0;
+        double EndToEndMs = 0.0;
+        FGameDirectorInferenceStats Stats;
+    };
+
+    struct FBenchmarkPercentiles
+    {
+        double Mean = 0.0;
+        double P50 = 0.0;
+        double P95 = 0.0;
+        double P99 = 0.0;
+    };
+
+    FBenchmarkPercentiles Summarize(TArray<double> Values)
+    {
+        FBenchmarkPercentiles Result;
+        if (Values.Num() == 0)
+        {
+            return Result;
+        }
+
+        Values.Sort();
+
+        double Sum = 0.0;
+        for (const double Value : Values)
+        {
+            Sum += Value;
+        }
+
+        Result.Mean = Sum / Values.Num();
+        Result.P50 = FGameDirectorStats::PercentileOfSorted(Values, 0.50);
+        Result.P95 = FGameDirectorStats::PercentileOfSorted(Values, 0.95);
+        Result.P99 = FGameDirectorStats::PercentileOfSorted(Values, 0.99);
+        return Result;
+    }
+
+    bool IsInputScenario(const FString& Line)
+    {
+        TSharedPtr<FJsonObject> Object;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+        if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+        {
+            return false;
+        }
+
+        FString Schema;
+        return Object->TryGetStringField(TEXT("schema"), Schema) && Schema == kInputSchema;
+    }
+
+    void LoadCorpusFile(const FString& FilePath, TArray<FGameDirectorRecordEntry>& OutEntries)
+    {
+        FString Contents;
+        if (!FFileHelper::LoadFileToString(Contents, *FilePath))
+        {
+            UE_LOG(LogGameDirectorBenchmark, Warning, TEXT("Unable to read corpus file %s."), *FilePath);
+            return;
+        }
+
+        TArray<FString> Lines;
+        if (FilePath.EndsWith(TEXT(".json")))
+        {
+            Lines.Add(Contents);
+        }
+        else
+        {
+            Contents.ParseIntoArrayLines(Lines, true);
+        }
+
+        int32 Skipped = 0;
+        for (FString& Line : Lines)
+        {
+            Line.TrimStartAndEndInline();
+            if (Line.IsEmpty())
+            {
+                continue;
+            }
+
+            // Plain scenarios and FGameDirectorRecorder logs are both accepted; recordings also carry the
+            // original response and latency for drift and regression checks.
+            FGameDirectorRecordEntry Entry;
+            if (IsInputScenario(Line))
+            {
+                Entry.ScenarioJSON = Line;
+                OutEntries.Add(MoveTemp(Entry));
+            }
+            else if (FGameDirectorRecorder::ParseLine(Line, Entry) && IsInputScenario(Entry.ScenarioJSON))
+            {
+                OutEntries.Add(MoveTemp(Entry));
+            }
+            else
+            {
+                ++Skipped;
+            }
+        }
+
+        if (Skipped > 0)
+        {
+            UE_LOG(LogGameDirectorBenchmark, Warning, TEXT("Skipped %d entries in %s that are not %s scenarios."), Skipped, *FilePath, kInputSchema);
+        }
+    }
+
+    void LoadCorpus(const FString& CorpusPath, TArray<FGameDirectorRecordEntry>& OutEntries)
+    {
+        if (FPaths::DirectoryExists(CorpusPath))
+        {
+            TArray<FString> Files;
+            IFileManager::Get().FindFilesRecursive(Files, *CorpusPath, TEXT("*.json"), true, false);
+            IFileManager::Get().FindFilesRecursive(Files, *CorpusPath, TEXT("*.ndjson"), true, false, false);
+            IFileManager::Get().FindFilesRecursive(Files, *CorpusPath, TEXT("*.jsonl"), true, false, false);
+            Files.Sort();
+
+            for (const FString& File : Files)
+            {
+                LoadCorpusFile(File, OutEntries);
+            }
+        }
+        else if (FPaths::FileExists(CorpusPath))
+        {
+            LoadCorpusFile(CorpusPath, OutEntries);
+        }
+    }
+
+    /** Deterministic spread of player health and enemy pressure so runs stay comparable without a recorded corpus. */
+    void MakeSyntheticCorpus(TArray<FGameDirectorRecordEntry>& OutEntries)
+    {
+        FRandomStream Random(1337);
+
+        for (int32 Index = 0; Index < 32; ++Index)
+        {
+            FGameDirectorScenario Scenario;
+            Scenario.PlayerHealth = Random.FRandRange(0.05f, 1.0f);
+            Scenario.EnemyCount = Random.RandRange(0, 12);
+            Scenario.AvgEnemyDistance = Random.FRandRange(300.0f, 4000.0f);
+
+            FGameDirectorRecordEntry& Entry = OutEntries.AddDefaulted_GetRef();
+            Entry.ScenarioJSON = Scenario.ToJSON();
+        }
+    }
+
+    /** Returns true for a well-formed gda.fps.output.v1 response and hands back the args of its first AdjustAIDifficulty call. */
+    bool ParseOutput(const FString& Response, TSharedPtr<FJsonObject>& OutArgs)
+    {
+        TSharedPtr<FJsonObject> Root;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+        if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+        {
+            return false;
+        }
+
+        FString Schema;
+        if (!Root->TryGetStringField(TEXT("schema"), Schema) || Schema != kOutputSchema)
+        {
+            return false;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* ToolCalls = nullptr;
+        if (!Root->TryGetArrayField(TEXT("tool_calls"), ToolCalls) || ToolCalls->Num() == 0)
+        {
+            return false;
+        }
+
+        for (const TSharedPtr<FJsonValue>& ToolCallValue : *ToolCalls)
+        {
+            const TSharedPtr<FJsonObject>* ToolCall = nullptr;
+            const TSharedPtr<FJsonObject>* Args = nullptr;
+            if (!ToolCallValue.IsValid() || !ToolCallValue->TryGetObject(ToolCall)
+                || !(*ToolCall)->TryGetObjectField(TEXT("args"), Args))
+            {
+                return false;
+            }
+
+            FString ToolName;
+            if (!OutArgs.IsValid() && (*ToolCall)->TryGetStringField(TEXT("name"), ToolName) && ToolName == TEXT("AdjustAIDifficulty"))
+            {
+                OutArgs = *Args;
+            }
+        }
+
+        return true;
+    }
+
+    /** Sum of absolute differences of the integer difficulty levels between two AdjustAIDifficulty calls. */
+    int32 CompareDecisions(const FJsonObject& Lhs, const FJsonObject& Rhs)
+    {
+        static const TCHAR* kLevelFields[] = { TEXT("aim_spread_level"), TEXT("reaction_level"), TEXT("aggression_level"), TEXT("peek_level") };
+
+        int32 Delta = 0;
+        for (const TCHAR* Field : kLevelFields)
+        {
+            int32 LhsValue = 0;
+            int32 RhsValue = 0;
+            Lhs.TryGetNumberField(Field, LhsValue);
+            Rhs.TryGetNumberField(Field, RhsValue);
+            Delta += FMath::Abs(LhsValue - RhsValue);
+        }
+
+        return Delta;
+    }
+
+    FName ResolveBenchmarkModel(const FGameDirectorModelManager& ModelManager, FName RequestedModel)
+    {
+        const UGameDirectorSubsystem* Defaults = GetDefault<UGameDirectorSubsystem>();
+
+        FName ModelName = RequestedModel.IsNone() ? Defaults->DefaultModelName : RequestedModel;
+        if (ModelName.IsNone())
+        {
+            const TArray<FName> ModelIds = ModelManager.GetRegisteredModels();
+            if (ModelIds.Num() == 0)
+            {
+                return NAME_None;
+            }
+            ModelName = ModelIds[0];
+        }
+
+        if (ModelManager.IsRegistered(ModelName))
+        {
+            return ModelName;
+        }
+
+        FGameDirectorModelBudget Budget;
+        Budget.MaxModelBytes = static_cast<uint64>(FMath::Max(0, Defaults->MaxModelVariantMB)) * 1024 * 1024;
+        Budget.MaxDecodeMsPerToken = Defaults->MaxDecodeMsPerToken;
+        Budget.MemoryBandwidthGBps = Defaults->MemoryBandwidthGBps;
+        return ModelManager.SelectVariant(ModelName.ToString(), Budget);
+    }
+
+    void AddPercentiles(const TSharedRef<FJsonObject>& Object, const TCHAR* Name, const FBenchmarkPercentiles& Percentiles)
+    {
+        const TSharedRef<FJsonObject> Field = MakeShared<FJsonObject>();
+        Field->SetNumberField(TEXT("mean"), Percentiles.Mean);
+        Field->SetNumberField(TEXT("p50"), Percentiles.P50);
+        Field->SetNumberField(TEXT("p95"), Percentiles.P95);
+        Field->SetNumberField(TEXT("p99"), Percentiles.P99);
+        Object->SetObjectField(Name, Field);
+    }
+}
+
+UGameDirectorBenchmarkCommandlet::UGameDirectorBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UGameDirectorBenchmarkCommandlet::Main(const FString& Params)
+{
+    const FString ModelsDirectory = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("AIModels"));
+
+    FString ModelParam;
+    FParse::Value(*Params, TEXT("Model="), ModelParam);
+
+    FString CorpusPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameDirector"), TEXT("Corpus"));
+    FParse::Value(*Params, TEXT("Corpus="), CorpusPath);
+
+    int32 Requests = 0;
+    FParse::Value(*Params, TEXT("Requests="), Requests);
+
+    int32 Concurrency = 1;
+    FParse::Value(*Params, TEXT("Concurrency="), Concurrency);
+    Concurrency = FMath::Max(1, Concurrency);
+
+    int32 Warmup = 1;
+    FParse::Value(*Params, TEXT("Warmup="), Warmup);
+
+    const bool bPaced = FParse::Param(*Params, TEXT("Paced"));
+
+    const bool bMock = FParse::Param(*Params, TEXT("Mock"));
+    if (!bMock && !FLlamaRunner::IsAvailable())
+    {
+        UE_LOG(LogGameDirectorBenchmark, Error, TEXT("GameDirector was built without llama.cpp (WITH_LLAMA=0); only -Mock runs are possible."));
+        return 1;
+    }
+
+    float MockLatencyMs = 0.0f;
+    FParse::Value(*Params, TEXT("MockLatencyMs="), MockLatencyMs);
+
+    float MockLatencySpreadMs = 0.0f;
+    FParse::Value(*Params, TEXT("MockLatencySpreadMs="), MockLatencySpreadMs);
+
+    FString OutputPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameDirector"), TEXT("Benchmark"),
+        FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString()));
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    //--- Corpus ---------------------------------------------------------------
+    TArray<FGameDirectorRecordEntry> Corpus;
+    LoadCorpus(CorpusPath, Corpus);
+
+    if (Corpus.Num() == 0)
+    {
+        UE_LOG(LogGameDirectorBenchmark, Display, TEXT("No scenarios found under %s; using the synthetic corpus."), *CorpusPath);
+        MakeSyntheticCorpus(Corpus);
+    }
+
+    if (Requests <= 0)
+    {
+        Requests = Corpus.Num();
+    }
+
+    // Parsed up front, as gameplay does, so the timed loop only measures the typed path.
+    TArray<FGameDirectorScenario> Scenarios;
+    Scenarios.SetNum(Corpus.Num());
+    for (int32 Index = 0; Index < Corpus.Num(); ++Index)
+    {
+        FGameDirectorScenario::FromJSON(Corpus[Index].ScenarioJSON, Scenarios[Index]);
+    }
+
+    //--- Cold start -----------------------------------------------------------
+    FLlamaRunner::InitializeBackend();
+
+    TSharedPtr<FGameDirectorModelManager> ModelManager;
+    TSharedPtr<ILlamaRunner> Runner;
+    FName ModelId = TEXT("Mock");
+    double ColdStartMs = 0.0;
+
+    if (bMock)
+    {
+        // Measures the scheduling path alone: queue throughput, lock contention and dispatch cost.
+        FMockLlamaRunnerSettings MockSettings;
+        MockSettings.Distribution = MockLatencySpreadMs > 0.0f ? EMockLatencyDistribution::LogNormal : EMockLatencyDistribution::Fixed;
+        MockSettings.LatencyMs = MockLatencyMs;
+        MockSettings.LatencySpreadMs = MockLatencySpreadMs;
+        Runner = MakeShared<FMockLlamaRunner>(MockSettings);
+    }
+    else
+    {
+        ModelManager = MakeShared<FGameDirectorModelManager>(0);
+        ModelManager->DiscoverModels(ModelsDirectory);
+
+        ModelId = ResolveBenchmarkModel(*ModelManager, ModelParam.IsEmpty() ? NAME_None : FName(*ModelParam));
+        if (ModelId.IsNone())
+        {
+            UE_LOG(LogGameDirectorBenchmark, Error, TEXT("No model to benchmark under %s."), *ModelsDirectory);
+            FLlamaRunner::ShutdownBackend();
+            return 1;
+        }
+
+        const double LoadStart = FPlatformTime::Seconds();
+        Runner = ModelManager->AcquireRunner(ModelId);
+        ColdStartMs = (FPlatformTime::Seconds() - LoadStart) * 1000.0;
+
+        if (!Runner.IsValid())
+        {
+            UE_LOG(LogGameDirectorBenchmark, Error, TEXT("Failed to load model %s."), *ModelId.ToString());
+            FLlamaRunner::ShutdownBackend();
+            return 1;
+        }
+
+        UE_LOG(LogGameDirectorBenchmark, Display, TEXT("Loaded %s (%.1f MB) in %.1f ms."),
+            *ModelId.ToString(), Runner->GetModelSizeBytes() / (1024.0 * 1024.0), ColdStartMs);
+    }
+
+    for (int32 Index = 0; Index < Warmup; ++Index)
+    {
+        Runner->RunInference(Scenarios[Index % Scenarios.Num()]);
+    }
+
+    //--- Run ------------------------------------------------------------------
+    FGameDirectorStats::Get().Reset();
+
+    const TSharedPtr<FGameDirectorJobQueue> JobQueue = ModelManager.IsValid()
+        ? MakeShared<FGameDirectorJobQueue>(ModelManager, ModelId, Concurrency)
+        : MakeShared<FGameDirectorJobQueue>(Runner, Concurrency);
+
+    TArray<FBenchmarkSample> Samples;
+    Samples.SetNum(Requests);
+
+    TArray<TSharedPtr<FGameDirectorJob>> Jobs;
+    Jobs.Reserve(Requests);
+
+    int32 CompletedCount = 0;
+    int32 EnqueuedCount = 0;
+    const double RunStart = FPlatformTime::Seconds();
+    const double FirstRecordedTime = Corpus[0].TimeSeconds;
+    const double CorpusSpan = Corpus.Last().TimeSeconds - FirstRecordedTime;
+
+    while (CompletedCount < Requests)
+    {
+        // -Paced replays a recording at its original request spacing; otherwise everything is queued up front.
+        while (EnqueuedCount < Requests)
+        {
+            const FGameDirectorRecordEntry& Entry = Corpus[EnqueuedCount % Corpus.Num()];
+            const FGameDirectorScenario& Scenario = Scenarios[EnqueuedCount % Corpus.Num()];
+            const int32 Pass = EnqueuedCount / Corpus.Num();
+            if (bPaced)
+            {
+                const double DueTime = Pass * CorpusSpan + (Entry.TimeSeconds - FirstRecordedTime);
+                if (FPlatformTime::Seconds() - RunStart < DueTime)
+                {
+                    break;
+                }
+            }
+
+            FBenchmarkSample& Sample = Samples[EnqueuedCount];
+            Sample.Recorded = &Entry;
+
+            const TSharedPtr<FGameDirectorJob> Job = MakeShared<FGameDirectorJob>(TEXT("Benchmark"), Scenario);
+            Job->AdapterId = Entry.AdapterId;
+            Job->OnComplete = [&Sample, &CompletedCount, JobPtr = Job.Get()](const FString& Result)
+            {
+                Sample.Response = Result;
+                Sample.EndToEndMs = (FPlatformTime::Seconds() - JobPtr->EnqueueSeconds) * 1000.0;
+                Sample.QueueWaitMs = JobPtr->QueueWaitMs;
+                Sample.Stats = JobPtr->InferenceStats;
+                ++CompletedCount;
+            };
+
+            Jobs.Add(Job);
+            JobQueue->EnqueueJob(Job);
+            ++EnqueuedCount;
+        }
+
+        JobQueue->Tick();
+        FPlatformProcess::Sleep(0.001f);
+    }
+
+    const double WallMs = (FPlatformTime::Seconds() - RunStart) * 1000.0;
+
+    //--- Report ---------------------------------------------------------------
+    TArray<double> EndToEnd;
+    TArray<double> QueueWait;
+    TArray<double> Inference;
+    TArray<double> TimeToFirstToken;
+    TArray<double> TokensPerSecond;
+    TArray<double> PromptTokensPerSecond;
+    TArray<double> RecordedLatency;
+    int32 ValidCount = 0;
+    int32 ComparedCount = 0;
+    int32 ChangedCount = 0;
+    int32 TotalLevelDelta = 0;
+
+    for (FBenchmarkSample& Sample : Samples)
+    {
+        TSharedPtr<FJsonObject> Args;
+        Sample.bValidOutput = ParseOutput(Sample.Response, Args);
+        ValidCount += Sample.bValidOutput ? 1 : 0;
+
+        if (Sample.Recorded && Sample.Recorded->LatencyMs > 0.0)
+        {
+            RecordedLatency.Add(Sample.Recorded->LatencyMs);
+        }
+
+        TSharedPtr<FJsonObject> RecordedArgs;
+        if (Args.IsValid() && Sample.Recorded && ParseOutput(Sample.Recorded->ResponseJSON, RecordedArgs) && RecordedArgs.IsValid())
+        {
+            Sample.LevelDelta = CompareDecisions(*Args, *RecordedArgs);
+            Sample.bDecisionChanged = Sample.LevelDelta > 0;
+
+            ++ComparedCount;
+            ChangedCount += Sample.bDecisionChanged ? 1 : 0;
+            TotalLevelDelta += Sample.LevelDelta;
+        }
+
+        EndToEnd.Add(Sample.EndToEndMs);
+        QueueWait.Add(Sample.QueueWaitMs);
+        Inference.Add(Sample.Stats.TotalMs);
+        TimeToFirstToken.Add(Sample.Stats.TimeToFirstTokenMs);
+        TokensPerSecond.Add(Sample.Stats.TokensPerSecond);
+        PromptTokensPerSecond.Add(Sample.Stats.PromptTokensPerSecond);
+    }
+
+    const FBenchmarkPercentiles EndToEndSummary = Summarize(EndToEnd);
+    const FBenchmarkPercentiles QueueWaitSummary = Summarize(QueueWait);
+    const FBenchmarkPercentiles InferenceSummary = Summarize(Inference);
+    const FBenchmarkPercentiles TimeToFirstTokenSummary = Summarize(TimeToFirstToken);
+    const FBenchmarkPercentiles TokensPerSecondSummary = Summarize(TokensPerSecond);
+    const FBenchmarkPercentiles PromptTokensPerSecondSummary = Summarize(PromptTokensPerSecond);
+    const FBenchmarkPercentiles RecordedLatencySummary = Summarize(RecordedLatency);
+    const double ValidityRate = Requests > 0 ? static_cast<double>(ValidCount) / Requests : 0.0;
+    const double DriftRate = ComparedCount > 0 ? static_cast<double>(ChangedCount) / ComparedCount : 0.0;
+    const double MeanLevelDelta = ComparedCount > 0 ? static_cast<double>(TotalLevelDelta) / ComparedCount : 0.0;
+
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("Model %s, %d requests at concurrency %d in %.1f ms (%.2f req/s)."),
+        *ModelId.ToString(), Requests, Concurrency, WallMs, WallMs > 0.0 ? Requests * 1000.0 / WallMs : 0.0);
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  Cold start          %10.1f ms"), ColdStartMs);
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  End to end   (ms)   p50 %8.1f  p95 %8.1f  p99 %8.1f"), EndToEndSummary.P50, EndToEndSummary.P95, EndToEndSummary.P99);
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  Queue wait   (ms)   p50 %8.1f  p95 %8.1f  p99 %8.1f"), QueueWaitSummary.P50, QueueWaitSummary.P95, QueueWaitSummary.P99);
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  TTFT         (ms)   p50 %8.1f  p95 %8.1f  p99 %8.1f"), TimeToFirstTokenSummary.P50, TimeToFirstTokenSummary.P95, TimeToFirstTokenSummary.P99);
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  Generation   (tok/s) mean %7.1f  p50 %8.1f"), TokensPerSecondSummary.Mean, TokensPerSecondSummary.P50);
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  Prompt       (tok/s) mean %7.1f  p50 %8.1f"), PromptTokensPerSecondSummary.Mean, PromptTokensPerSecondSummary.P50);
+    UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  Valid JSON          %10.1f %% (%d/%d)"), ValidityRate * 100.0, ValidCount, Requests);
+
+    if (RecordedLatency.Num() > 0)
+    {
+        UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  Recorded     (ms)   p50 %8.1f  p95 %8.1f  p99 %8.1f"), RecordedLatencySummary.P50, RecordedLatencySummary.P95, RecordedLatencySummary.P99);
+    }
+
+    if (ComparedCount > 0)
+    {
+        UE_LOG(LogGameDirectorBenchmark, Display, TEXT("  Decision drift      %10.1f %% changed (%d/%d), mean level delta %.2f"),
+            DriftRate * 100.0, ChangedCount, ComparedCount, MeanLevelDelta);
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputPath), true);
+
+    bool bWritten = false;
+    if (OutputPath.EndsWith(TEXT(".csv")))
+    {
+        FString Csv = TEXT("index,valid_json,decision_changed,level_delta,recorded_latency_ms,end_to_end_ms,queue_wait_ms,inference_ms,ttft_ms,tokenize_ms,prompt_decode_ms,per_token_decode_ms,sample_ms,prompt_tokens,generated_tokens,prompt_tok_s,gen_tok_s\n");
+        for (int32 Index = 0; Index < Samples.Num(); ++Index)
+        {
+            const FBenchmarkSample& Sample = Samples[Index];
+            Csv += FString::Printf(TEXT("%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%d,%.2f,%.2f\n"),
+                Index,
+                Sample.bValidOutput ? 1 : 0,
+                Sample.bDecisionChanged ? 1 : 0,
+                Sample.LevelDelta,
+                Sample.Recorded ? Sample.Recorded->LatencyMs : 0.0,
+                Sample.EndToEndMs,
+                Sample.QueueWaitMs,
+                Sample.Stats.TotalMs,
+                Sample.Stats.TimeToFirstTokenMs,
+                Sample.Stats.TokenizeMs,
+                Sample.Stats.PromptDecodeMs,
+                Sample.Stats.GetPerTokenDecodeMs(),
+                Sample.Stats.SampleMs,
+                Sample.Stats.PromptTokens,
+                Sample.Stats.GeneratedTokens,
+                Sample.Stats.PromptTokensPerSecond,
+                Sample.Stats.TokensPerSecond);
+        }
+
+        bWritten = FFileHelper::SaveStringToFile(Csv, *OutputPath);
+    }
+    else
+    {
+        const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+        Report->SetStringField(TEXT("model"), ModelId.ToString());
+        Report->SetNumberField(TEXT("model_bytes"), static_cast<double>(Runner->GetModelSizeBytes()));
+        Report->SetNumberField(TEXT("requests"), Requests);
+        Report->SetNumberField(TEXT("concurrency"), Concurrency);
+        Report->SetNumberField(TEXT("corpus_size"), Corpus.Num());
+        Report->SetNumberField(TEXT("cold_start_ms"), ColdStartMs);
+        Report->SetNumberField(TEXT("wall_ms"), WallMs);
+        Report->SetNumberField(TEXT("json_validity_rate"), ValidityRate);
+        Report->SetNumberField(TEXT("decisions_compared"), ComparedCount);
+        Report->SetNumberField(TEXT("decision_drift_rate"), DriftRate);
+        Report->SetNumberField(TEXT("mean_level_delta"), MeanLevelDelta);
+        AddPercentiles(Report, TEXT("recorded_latency_ms"), RecordedLatencySummary);
+        AddPercentiles(Report, TEXT("end_to_end_ms"), EndToEndSummary);
+        AddPercentiles(Report, TEXT("queue_wait_ms"), QueueWaitSummary);
+        AddPercentiles(Report, TEXT("inference_ms"), InferenceSummary);
+        AddPercentiles(Report, TEXT("ttft_ms"), TimeToFirstTokenSummary);
+        AddPercentiles(Report, TEXT("gen_tok_s"), TokensPerSecondSummary);
+        AddPercentiles(Report, TEXT("prompt_tok_s"), PromptTokensPerSecondSummary);
+
+        TArray<TSharedPtr<FJsonValue>> Rows;
+        for (const FBenchmarkSample& Sample : Samples)
+        {
+            const TSharedRef<FJsonObject> Row = MakeShared<FJsonObject>();
+            Row->SetBoolField(TEXT("valid_json"), Sample.bValidOutput);
+            Row->SetBoolField(TEXT("decision_changed"), Sample.bDecisionChanged);
+            Row->SetNumberField(TEXT("level_delta"), Sample.LevelDelta);
+            Row->SetNumberField(TEXT("end_to_end_ms"), Sample.EndToEndMs);
+            Row->SetNumberField(TEXT("queue_wait_ms"), Sample.QueueWaitMs);
+            Row->SetNumberField(TEXT("inference_ms"), Sample.Stats.TotalMs);
+            Row->SetNumberField(TEXT("ttft_ms"), Sample.Stats.TimeToFirstTokenMs);
+            Row->SetNumberField(TEXT("prompt_tokens"), Sample.Stats.PromptTokens);
+            Row->SetNumberField(TEXT("generated_tokens"), Sample.Stats.GeneratedTokens);
+            Row->SetNumberField(TEXT("gen_tok_s"), Sample.Stats.TokensPerSecond);
+            Rows.Add(MakeShared<FJsonValueObject>(Row));
+        }
+        Report->SetArrayField(TEXT("samples"), Rows);
+
+        FString Json;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        bWritten = FJsonSerializer::Serialize(Report, Writer) && FFileHelper::SaveStringToFile(Json, *OutputPath);
+    }
+
+    if (bWritten)
+    {
+        UE_LOG(LogGameDirectorBenchmark, Display, TEXT("Wrote report to %s"), *OutputPath);
+    }
+    else
+    {
+        UE_LOG(LogGameDirectorBenchmark, Error, TEXT("Failed to write report to %s"), *OutputPath);
+    }
+
+    Jobs.Reset();
+    Runner.Reset();
+    if (ModelManager.IsValid())
+    {
+        ModelManager->EvictAll();
+    }
+    FLlamaRunner::ShutdownBackend();
+
+    return bWritten ? 0 : 1;
+}
@@ -0,0 +1,243 @@
+#include "GameDirectorCombatScheduler.h"
+
+#include "EnemyCharacter.h"
+#include "Engine/World.h"
+#include "GameDirectorStats.h"
+
+void UGameDirectorCombatScheduler::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    Buckets.SetNum(WheelSize);
+    TickResolution = FMath::Max(TickResolution, 1.0f / 1000.0f);
+}
+
+void UGameDirectorCombatScheduler::Deinitialize()
+{
+    Enemies.Reset();
+    Generations.Reset();
+    FreeSlots.Reset();
+    Buckets.Reset();
+    NumPending = 0;
+    QueuedShots.Reset();
+    InFlightShots.Reset();
+
+    Super::Deinitialize();
+}
+
+int32 UGameDirectorCombatScheduler::RegisterEnemy(AEnemyCharacter* Enemy)
+{
+    if (FreeSlots.Num() > 0)
+    {
+        const int32 Slot = FreeSlots.Pop(EAllowShrinking::No);
+        Enemies[Slot] = Enemy;
+        return Slot;
+    }
+
+    Generations.AddZeroed(NumEventTypes);
+    return Enemies.Add(Enemy);
+}
+
+void UGameDirectorCombatScheduler::UnregisterEnemy(int32 Slot)
+{
+    if (!Enemies.IsValidIndex(Slot) || !Enemies[Slot])
+    {
+        return;
+    }
+
+    for (int32 Type = 0; Type < NumEventTypes; ++Type)
+    {
+        ++GetGeneration(Slot, static_cast<EGameDirectorCombatEvent>(Type));
+    }
+
+    Enemies[Slot] = nullptr;
+    FreeSlots.Add(Slot);
+}
+
+void UGameDirectorCombatScheduler::Schedule(int32 Slot, EGameDirectorCombatEvent Event, float DelaySeconds)
+{
+    if (!Enemies.IsValidIndex(Slot) || Buckets.Num() != WheelSize)
+    {
+        return;
+    }
+
+    // At least one tick ahead so an event scheduled from a dispatch never runs in the same pass.
+    const int64 CurrentTick = FMath::FloorToInt64(ElapsedSeconds / TickResolution);
+    const int64 DueTick = FMath::Max(CurrentTick, NextTick) + FMath::Max<int64>(1, FMath::CeilToInt64(DelaySeconds / TickResolution));
+
+    FEvent& Entry = Buckets[DueTick & (WheelSize - 1)].AddDefaulted_GetRef();
+    Entry.DueTick = DueTick;
+    Entry.Slot = Slot;
+    Entry.Generation = ++GetGeneration(Slot, Event);
+    Entry.Type = Event;
+
+    ++NumPending;
+}
+
+void UGameDirectorCombatScheduler::Cancel(int32 Slot, EGameDirectorCombatEvent Event)
+{
+    if (Enemies.IsValidIndex(Slot))
+    {
+        ++GetGeneration(Slot, Event);
+    }
+}
+
+void UGameDirectorCombatScheduler::QueueShot(AEnemyCharacter* Enemy, const FVector& Start, const FVector& End)
+{
+    FShot& Shot = QueuedShots.AddDefaulted_GetRef();
+    Shot.Enemy = Enemy;
+    Shot.Start = Start;
+    Shot.End = End;
+}
+
+void UGameDirectorCombatScheduler::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_CombatSchedule);
+    FGameDirectorAITimeScope AITimeScope(this);
+
+    ResolveShots();
+
+    ElapsedSeconds += DeltaTime;
+    const int64 CurrentTick = FMath::FloorToInt64(ElapsedSeconds / TickResolution);
+
+    int32 Budget = MaxEventsPerFrame > 0 ? MaxEventsPerFrame : MAX_int32;
+
+    // Buckets past the first full turn of the wheel hold nothing new, so a long hitch visits each bucket at most once.
+    const int64 LastTick = FMath::Min(CurrentTick, NextTick + WheelSize - 1);
+    bool bOutOfBudget = false;
+
+    while (NextTick <= LastTick && !bOutOfBudget)
+    {
+        TArray<FEvent>& Bucket = Buckets[NextTick & (WheelSize - 1)];
+
+        for (int32 Index = 0; Index < Bucket.Num();)
+        {
+            const FEvent Event = Bucket[Index];
+            if (Event.DueTick > CurrentTick)
+            {
+                // Later turn of the wheel.
+                ++Index;
+                continue;
+            }
+
+            const bool bLive = Enemies.IsValidIndex(Event.Slot) && Event.Generation == GetGeneration(Event.Slot, Event.Type);
+            if (bLive && Budget == 0)
+            {
+                bOutOfBudget = true;
+                break;
+            }
+
+            Bucket.RemoveAtSwap(Index, EAllowShrinking::No);
+            --NumPending;
+
+            if (bLive)
+            {
+                --Budget;
+                Dispatch(Event);
+            }
+        }
+
+        if (!bOutOfBudget)
+        {
+            ++NextTick;
+        }
+    }
+
+    if (!bOutOfBudget && NextTick <= CurrentTick)
+    {
+        // Catching up after a hitch longer than the wheel; every due event was visited above.
+        NextTick = CurrentTick + 1;
+    }
+
+    int32 Deferred = 0;
+    if (bOutOfBudget)
+    {
+        for (const FEvent& Event : Buckets[NextTick & (WheelSize - 1)])
+        {
+            Deferred += Event.DueTick <= CurrentTick ? 1 : 0;
+        }
+    }
+    SET_DWORD_STAT(STAT_GameDirector_DeferredCombatEvents, Deferred);
+
+    SubmitShots();
+}
+
+void UGameDirectorCombatScheduler::ResolveShots()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        InFlightShots.Reset();
+        return;
+    }
+
+    FTraceDatum Datum;
+    for (int32 Index = 0; Index < InFlightShots.Num();)
+    {
+        const FShot& Shot = InFlightShots[Index];
+        if (World->QueryTraceData(Shot.Handle, Datum))
+        {
+            if (AEnemyCharacter* Enemy = Shot.Enemy.Get())
+            {
+                const FHitResult* Hit = (Datum.OutHits.Num() > 0 && Datum.OutHits[0].bBlockingHit) ? &Datum.OutHits[0] : nullptr;
+                Enemy->OnShotResolved(Shot.Start, Shot.End, Hit);
+            }
+        }
+        else if (World->IsTraceHandleValid(Shot.Handle, false))
+        {
+            // Still running; the world keeps results for one more frame.
+            ++Index;
+            continue;
+        }
+
+        InFlightShots.RemoveAtSwap(Index, EAllowShrinking::No);
+    }
+}
+
+void UGameDirectorCombatScheduler::SubmitShots()
+{
+    UWorld* World = GetWorld();
+    if (!World || QueuedShots.Num() == 0)
+    {
+        QueuedShots.Reset();
+        return;
+    }
+
+    InFlightShots.Reserve(InFlightShots.Num() + QueuedShots.Num());
+    for (FShot& Shot : QueuedShots)
+    {
+        AEnemyCharacter* Enemy = Shot.Enemy.Get();
+        if (!Enemy)
+        {
+            continue;
+        }
+
+        const FCollisionQueryParams Params(SCENE_QUERY_STAT(EnemyCharacterFire), false, Enemy);
+        Shot.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Shot.Start, Shot.End, ECC_Visibility, Params);
+        InFlightShots.Add(Shot);
+    }
+
+    QueuedShots.Reset();
+}
+
+void UGameDirectorCombatScheduler::Dispatch(const FEvent& Event)
+{
+    AEnemyCharacter* Enemy = Enemies[Event.Slot];
+    if (!IsValid(Enemy))
+    {
+        return;
+    }
+
+    switch (Event.Type)
+    {
+    case EGameDirectorCombatEvent::Fire:        Enemy->FireOneShot(); break;
+    case EGameDirectorCombatEvent::PeekToggle:  Enemy->TogglePeek(); break;
+    default:                                    break;
+    }
+}
+
+UGameDirectorCombatScheduler* UGameDirectorCombatScheduler::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGameDirectorCombatScheduler>() : nullptr;
+}
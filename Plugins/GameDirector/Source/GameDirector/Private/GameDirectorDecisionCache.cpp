@@ -0,0 +1,151 @@
+#include "GameDirectorDecisionCache.h"
+
+#include "GameDirectorStats.h"
+
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    /** Centre and half-range of each compact field; values outside the range still embed, just past +-1. */
+    struct FFeatureScale
+    {
+        float Centre;
+        float HalfRange;
+    };
+
+    const FFeatureScale kFeatureScales[] =
+    {
+        { 50.0f, 50.0f },   // hp, percent
+        { 6.0f, 6.0f },     // en
+        { 20.0f, 20.0f },   // dist, meters
+        { 10.0f, 10.0f },   // dtk
+        { 10.0f, 10.0f },   // ddl
+        { 40.0f, 40.0f },   // hit, percent
+        { 3.0f, 3.0f },     // k
+        { 2.0f, 2.0f },     // d
+        { 30.0f, 30.0f },   // sd, seconds
+        { 16.0f, 16.0f },   // gt, ms
+        { 20.0f, 20.0f },   // ai, tenths of a ms
+        { 500.0f, 500.0f }, // act
+    };
+    static_assert(UE_ARRAY_COUNT(kFeatureScales) == static_cast<int32>(FGameDirectorScenario::ECompactField::Count), "Missing feature scale");
+
+    /** Weight of the constant lane; larger values make the similarity more sensitive to distance from the centre. */
+    constexpr float kBiasLane = 1.0f;
+}
+
+FGameDirectorDecisionCache::FGameDirectorDecisionCache()
+{
+    Reset(256);
+}
+
+void FGameDirectorDecisionCache::Reset(int32 InCapacity)
+{
+    Capacity = FMath::Max(0, InCapacity);
+    NumEntries = 0;
+    NextSlot = 0;
+    Hits = 0;
+    Misses = 0;
+
+    Vectors.SetNumZeroed(Capacity * Stride);
+    Decisions.SetNum(Capacity);
+    AddedSeconds.SetNumZeroed(Capacity);
+}
+
+void FGameDirectorDecisionCache::Embed(const FGameDirectorScenario& Scenario, float* OutVector)
+{
+    float SumSquares = 0.0f;
+    for (int32 Index = 0; Index < Stride; ++Index)
+    {
+        float Value = 0.0f;
+        if (Index < NumFeatures)
+        {
+            // Missing telemetry or load embeds as the centre so it neither attracts nor repels scenarios that have it.
+            const FFeatureScale& Scale = kFeatureScales[Index];
+            const FGameDirectorScenario::ECompactField Field = static_cast<FGameDirectorScenario::ECompactField>(Index);
+            Value = Scenario.HasCompactField(Field)
+                ? (Scenario.GetCompactValue(Field) - Scale.Centre) / Scale.HalfRange
+                : 0.0f;
+        }
+        else if (Index == NumFeatures)
+        {
+            Value = kBiasLane;
+        }
+
+        OutVector[Index] = Value;
+        SumSquares += Value * Value;
+    }
+
+    const float InvLength = FMath::InvSqrt(SumSquares);
+    for (int32 Index = 0; Index < Stride; ++Index)
+    {
+        OutVector[Index] *= InvLength;
+    }
+}
+
+void FGameDirectorDecisionCache::Add(const FGameDirectorScenario& Scenario, const FAIDifficulty& Decision, double NowSeconds)
+{
+    if (Capacity == 0)
+    {
+        return;
+    }
+
+    Embed(Scenario, Vectors.GetData() + NextSlot * Stride);
+    Decisions[NextSlot] = Decision;
+    AddedSeconds[NextSlot] = NowSeconds;
+
+    NextSlot = (NextSlot + 1) % Capacity;
+    NumEntries = FMath::Min(NumEntries + 1, Capacity);
+}
+
+bool FGameDirectorDecisionCache::Find(const FGameDirectorScenario& Scenario, float MinSimilarity, double MaxAgeSeconds, double NowSeconds,
+    FAIDifficulty& OutDecision, float& OutSimilarity)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_DecisionCache);
+
+    if (NumEntries == 0)
+    {
+        ++Misses;
+        return false;
+    }
+
+    alignas(16) float Query[Stride];
+    Embed(Scenario, Query);
+
+    VectorRegister4Float QueryLanes[Stride / 4];
+    for (int32 Lane = 0; Lane < Stride / 4; ++Lane)
+    {
+        QueryLanes[Lane] = VectorLoadAligned(Query + Lane * 4);
+    }
+
+    int32 BestIndex = INDEX_NONE;
+    float BestSimilarity = -1.0f;
+
+    const float* Vector = Vectors.GetData();
+    for (int32 Index = 0; Index < NumEntries; ++Index, Vector += Stride)
+    {
+        VectorRegister4Float Sum = VectorZeroFloat();
+        for (int32 Lane = 0; Lane < Stride / 4; ++Lane)
+        {
+            Sum = VectorMultiplyAdd(VectorLoadAligned(Vector + Lane * 4), QueryLanes[Lane], Sum);
+        }
+
+        const float Similarity = VectorGetComponent(VectorDot4(Sum, VectorOneFloat()), 0);
+        if (Similarity > BestSimilarity && (MaxAgeSeconds <= 0.0 || NowSeconds - AddedSeconds[Index] <= MaxAgeSeconds))
+        {
+            BestSimilarity = Similarity;
+            BestIndex = Index;
+        }
+    }
+
+    OutSimilarity = BestSimilarity;
+    if (BestIndex == INDEX_NONE || BestSimilarity < MinSimilarity)
+    {
+        ++Misses;
+        return false;
+    }
+
+    ++Hits;
+    OutDecision = Decisions[BestIndex];
+    return true;
+}
@@ -0,0 +1,273 @@
+#include "GameDirectorDifficultyBlender.h"
+
+#include "EnemyCharacter.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameDirectorStats.h"
+#include "GameDirectorSubsystem.h"
+
+void UGameDirectorDifficultyBlender::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    BakeTable();
+
+#if WITH_EDITOR
+    CurvesChangedHandle = UGameDirectorDifficultyCurves::OnCurvesChanged.AddWeakLambda(this, [this](const UGameDirectorDifficultyCurves* Curves)
+    {
+        if (Curves == DifficultyCurves.Get())
+        {
+            BakeTable();
+
+            // Re-derive every target from the new table, keeping per-enemy overrides.
+            if (const UGameDirectorSubsystem* Director = GetDirector())
+            {
+                RetargetAll(Director->GetDifficultySnapshot().Difficulty);
+            }
+        }
+    });
+#endif
+}
+
+void UGameDirectorDifficultyBlender::Deinitialize()
+{
+#if WITH_EDITOR
+    UGameDirectorDifficultyCurves::OnCurvesChanged.Remove(CurvesChangedHandle);
+#endif
+
+    Enemies.Reset();
+    IndexByEnemy.Reset();
+    Overrides.Reset();
+    HasOverride.Reset();
+    Moved.Reset();
+    for (int32 Param = 0; Param < NumParams; ++Param)
+    {
+        Current[Param].Reset();
+        Target[Param].Reset();
+    }
+
+    Super::Deinitialize();
+}
+
+void UGameDirectorDifficultyBlender::RegisterEnemy(AEnemyCharacter* Enemy, const FGameDirectorEnemyParams& Params)
+{
+    if (!Enemy || IndexByEnemy.Contains(Enemy))
+    {
+        return;
+    }
+
+    const int32 Index = Enemies.Add(Enemy);
+    IndexByEnemy.Add(Enemy, Index);
+    for (int32 Param = 0; Param < NumParams; ++Param)
+    {
+        Current[Param].AddUninitialized();
+        Target[Param].AddUninitialized();
+    }
+    Overrides.AddDefaulted();
+    HasOverride.Add(false);
+
+    // Spawning into an ongoing fight takes the current difficulty directly; there is nothing to ease from.
+    const UGameDirectorSubsystem* Director = GetDirector();
+    const bool bHasGlobal = Director && Director->GetDifficultyVersion() > 0;
+
+    const FGameDirectorEnemyParams Initial = bHasGlobal ? Evaluate(Director->GetDifficultySnapshot().Difficulty) : Params;
+    SetCurrentAt(Index, Initial);
+    SetTargetAt(Index, Initial);
+
+    Enemy->SetCombatParams(Initial);
+}
+
+void UGameDirectorDifficultyBlender::UnregisterEnemy(AEnemyCharacter* Enemy)
+{
+    int32 Index = INDEX_NONE;
+    if (IndexByEnemy.RemoveAndCopyValue(Enemy, Index))
+    {
+        RemoveAtSwap(Index);
+    }
+}
+
+void UGameDirectorDifficultyBlender::RemoveAtSwap(int32 Index)
+{
+    const int32 LastIndex = Enemies.Num() - 1;
+    if (Index != LastIndex)
+    {
+        IndexByEnemy.FindChecked(Enemies[LastIndex]) = Index;
+    }
+
+    Enemies.RemoveAtSwap(Index, EAllowShrinking::No);
+    for (int32 Param = 0; Param < NumParams; ++Param)
+    {
+        Current[Param].RemoveAtSwap(Index, EAllowShrinking::No);
+        Target[Param].RemoveAtSwap(Index, EAllowShrinking::No);
+    }
+    Overrides.RemoveAtSwap(Index, EAllowShrinking::No);
+    HasOverride.RemoveAtSwap(Index);
+}
+
+void UGameDirectorDifficultyBlender::SetTarget(AEnemyCharacter* Enemy, const FAIDifficulty& Difficulty)
+{
+    if (const int32* Index = IndexByEnemy.Find(Enemy))
+    {
+        Overrides[*Index] = Difficulty;
+        HasOverride[*Index] = true;
+        SetTargetAt(*Index, Evaluate(Difficulty));
+        bBlending = true;
+    }
+}
+
+void UGameDirectorDifficultyBlender::SetTargetAt(int32 Index, const FGameDirectorEnemyParams& Params)
+{
+    Target[ReactionDelay][Index] = Params.ReactionDelay;
+    Target[AimSpread][Index] = Params.AimSpread;
+    Target[FireRate][Index] = Params.FireRate;
+    Target[BurstCount][Index] = Params.BurstCount;
+    Target[PeekInterval][Index] = Params.PeekInterval;
+}
+
+void UGameDirectorDifficultyBlender::SetCurrentAt(int32 Index, const FGameDirectorEnemyParams& Params)
+{
+    Current[ReactionDelay][Index] = Params.ReactionDelay;
+    Current[AimSpread][Index] = Params.AimSpread;
+    Current[FireRate][Index] = Params.FireRate;
+    Current[BurstCount][Index] = Params.BurstCount;
+    Current[PeekInterval][Index] = Params.PeekInterval;
+}
+
+FGameDirectorEnemyParams UGameDirectorDifficultyBlender::GetCurrentAt(int32 Index) const
+{
+    FGameDirectorEnemyParams Params;
+    Params.ReactionDelay = Current[ReactionDelay][Index];
+    Params.AimSpread = Current[AimSpread][Index];
+    Params.FireRate = Current[FireRate][Index];
+    Params.BurstCount = Current[BurstCount][Index];
+    Params.PeekInterval = Current[PeekInterval][Index];
+    return Params;
+}
+
+FGameDirectorEnemyParams UGameDirectorDifficultyBlender::Evaluate(const FAIDifficulty& Difficulty) const
+{
+    // Published snapshots are already capped, but per-enemy overrides come straight from the caller. Fire rate is only
+    // known once the level is mapped. Changing the caps republishes the global snapshot, so FollowGlobalDifficulty
+    // re-evaluates every enemy.
+    const UGameDirectorSubsystem* Director = GetDirector();
+    FGameDirectorEnemyParams Params = Table.Evaluate(Director ? Director->CapDifficulty(Difficulty) : Difficulty);
+    if (Director && Director->GetLoadCaps().bActive)
+    {
+        Params.FireRate = FMath::Min(Params.FireRate, Director->GetLoadCaps().MaxFireRate);
+    }
+    return Params;
+}
+
+void UGameDirectorDifficultyBlender::FollowGlobalDifficulty()
+{
+    const UGameDirectorSubsystem* Director = GetDirector();
+    if (!Director || Director->GetDifficultyVersion() == AppliedGlobalVersion)
+    {
+        return;
+    }
+
+    AppliedGlobalVersion = Director->GetDifficultyVersion();
+
+    // A republish with new caps but the same requested difficulty is not a new decision; overrides survive it.
+    const bool bNewDecision = Director->GetLoadCapsVersion() == AppliedLoadCapsVersion || Director->GetCurrentDifficulty() != AppliedGlobalDifficulty;
+    AppliedGlobalDifficulty = Director->GetCurrentDifficulty();
+    AppliedLoadCapsVersion = Director->GetLoadCapsVersion();
+
+    if (bNewDecision)
+    {
+        HasOverride.Init(false, Enemies.Num());
+    }
+
+    RetargetAll(Director->GetDifficultySnapshot().Difficulty);
+}
+
+void UGameDirectorDifficultyBlender::RetargetAll(const FAIDifficulty& Global)
+{
+    const FGameDirectorEnemyParams Params = Evaluate(Global);
+    const float Values[NumParams] = { Params.ReactionDelay, Params.AimSpread, Params.FireRate, Params.BurstCount, Params.PeekInterval };
+    for (int32 Param = 0; Param < NumParams; ++Param)
+    {
+        Target[Param].Init(Values[Param], Enemies.Num());
+    }
+
+    for (TConstSetBitIterator<> It(HasOverride); It; ++It)
+    {
+        SetTargetAt(It.GetIndex(), Evaluate(Overrides[It.GetIndex()]));
+    }
+
+    bBlending = true;
+}
+
+const UGameDirectorSubsystem* UGameDirectorDifficultyBlender::GetDirector() const
+{
+    const UGameInstance* GameInstance = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+    return GameInstance ? GameInstance->GetSubsystem<UGameDirectorSubsystem>() : nullptr;
+}
+
+void UGameDirectorDifficultyBlender::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_Blend);
+    FGameDirectorAITimeScope AITimeScope(this);
+
+    FollowGlobalDifficulty();
+
+    if (!bBlending)
+    {
+        return;
+    }
+
+    const int32 Count = Enemies.Num();
+    const float Alpha = BlendTimeConstant > 0.0f ? 1.0f - FMath::Exp(-DeltaTime / BlendTimeConstant) : 1.0f;
+
+    // Close enough to snap; well below anything the enemies can observe.
+    constexpr float SnapDistance = 0.005f;
+
+    Moved.Init(false, Count);
+
+    float MaxRemaining = 0.0f;
+    for (int32 Param = 0; Param < NumParams; ++Param)
+    {
+        float* RESTRICT Values = Current[Param].GetData();
+        const float* RESTRICT Targets = Target[Param].GetData();
+
+        for (int32 Index = 0; Index < Count; ++Index)
+        {
+            const float Delta = Targets[Index] - Values[Index];
+            const float Step = FMath::Abs(Delta) <= SnapDistance ? Delta : Delta * Alpha;
+            Values[Index] += Step;
+            if (Step != 0.0f)
+            {
+                Moved[Index] = true;
+            }
+            MaxRemaining = FMath::Max(MaxRemaining, FMath::Abs(Delta - Step));
+        }
+    }
+
+    // Enemies already at their targets are skipped, so a few stragglers do not cost a call on every actor.
+    for (TConstSetBitIterator<> It(Moved); It; ++It)
+    {
+        if (AEnemyCharacter* Enemy = Enemies[It.GetIndex()])
+        {
+            Enemy->SetCombatParams(GetCurrentAt(It.GetIndex()));
+        }
+    }
+
+    bBlending = MaxRemaining > 0.0f;
+}
+
+void UGameDirectorDifficultyBlender::BakeTable()
+{
+    const UGameDirectorDifficultyCurves* Curves = DifficultyCurves.IsNull() ? nullptr : DifficultyCurves.LoadSynchronous();
+    if (!DifficultyCurves.IsNull() && !Curves)
+    {
+        UE_LOG(LogGameDirector, Warning, TEXT("Difficulty curves %s could not be loaded; using the built-in mapping."), *DifficultyCurves.ToString());
+    }
+
+    Table = FGameDirectorDifficultyTable::Bake(Curves);
+}
+
+UGameDirectorDifficultyBlender* UGameDirectorDifficultyBlender::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGameDirectorDifficultyBlender>() : nullptr;
+}
@@ -0,0 +1,106 @@
+#include "GameDirectorDifficultyCurves.h"
+
+#include "GameDirectorDifficultyBlender.h"
+#include "GameDirectorSubsystem.h"
+#include "GameDirectorTypes.h"
+
+#if WITH_EDITOR
+TMulticastDelegate<void(const UGameDirectorDifficultyCurves*)> UGameDirectorDifficultyCurves::OnCurvesChanged;
+
+void UGameDirectorDifficultyCurves::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+    OnCurvesChanged.Broadcast(this);
+}
+#endif
+
+namespace
+{
+    /** Shots per second; any positive rate works, this just keeps the shot interval finite. */
+    constexpr float MinFireRate = 0.01f;
+
+    int32 LevelIndex(int32 Level)
+    {
+        return FMath::Clamp(Level, 0, FGameDirectorDifficultyTable::NumLevels - 1);
+    }
+
+    /** Samples Curve at every level, raising samples below MinValue to it so a bad key can't stall or divide by zero. */
+    void BakeCurve(const UGameDirectorDifficultyCurves& Curves, const FRuntimeFloatCurve& Curve, const TCHAR* CurveName, float MinValue,
+        TStaticArray<float, FGameDirectorDifficultyTable::NumLevels>& InOutValues)
+    {
+        const FRichCurve* RichCurve = Curve.GetRichCurveConst();
+        if (!RichCurve || RichCurve->GetNumKeys() == 0)
+        {
+            return;
+        }
+
+        int32 NumClamped = 0;
+        float LowestValue = MinValue;
+        for (int32 Level = 0; Level < FGameDirectorDifficultyTable::NumLevels; ++Level)
+        {
+            const float Value = RichCurve->Eval(static_cast<float>(Level));
+            if (Value < MinValue)
+            {
+                ++NumClamped;
+                LowestValue = FMath::Min(LowestValue, Value);
+            }
+            InOutValues[Level] = FMath::Max(Value, MinValue);
+        }
+
+        if (NumClamped > 0)
+        {
+            UE_LOG(LogGameDirector, Warning, TEXT("%s: %s curve drops to %.3f at %d level(s); clamped to %.3f."),
+                *Curves.GetPathName(), CurveName, LowestValue, NumClamped, MinValue);
+        }
+    }
+
+    FGameDirectorDifficultyTable MakeDefaultTable()
+    {
+        FGameDirectorDifficultyTable Table;
+        for (int32 Level = 0; Level < FGameDirectorDifficultyTable::NumLevels; ++Level)
+        {
+            Table.ReactionDelayByLevel[Level] = FMath::Clamp(1.5f - Level * 0.25f, 0.2f, 1.5f);
+            Table.AimSpreadByLevel[Level] = 5.0f - Level * 0.8f;
+            Table.FireRateByLevel[Level] = FMath::Clamp(1.0f + Level * 0.5f, 1.0f, 5.0f);
+            Table.BurstCountByLevel[Level] = static_cast<float>(FMath::Clamp(2 + Level, 2, 8));
+            Table.PeekIntervalByLevel[Level] = FMath::Clamp(3.0f - Level * 0.4f, 0.5f, 3.0f);
+        }
+        return Table;
+    }
+}
+
+FGameDirectorEnemyParams FGameDirectorDifficultyTable::Evaluate(const FAIDifficulty& Difficulty) const
+{
+    FGameDirectorEnemyParams Params;
+    Params.ReactionDelay = ReactionDelayByLevel[LevelIndex(Difficulty.ReactionLevel)];
+    Params.AimSpread = FMath::Clamp(AimSpreadByLevel[LevelIndex(Difficulty.AimSpreadLevel)] + Difficulty.AimSpreadFine, MinAimSpread, MaxAimSpread);
+    Params.FireRate = FireRateByLevel[LevelIndex(Difficulty.AggressionLevel)];
+    Params.BurstCount = BurstCountByLevel[LevelIndex(Difficulty.AggressionLevel)];
+    Params.PeekInterval = PeekIntervalByLevel[LevelIndex(Difficulty.PeekLevel)];
+    return Params;
+}
+
+FGameDirectorDifficultyTable FGameDirectorDifficultyTable::Bake(const UGameDirectorDifficultyCurves* Curves)
+{
+    FGameDirectorDifficultyTable Table = Default();
+    if (!Curves)
+    {
+        return Table;
+    }
+
+    // Aim spread is clamped per evaluation against MinAimSpread/MaxAimSpread instead.
+    BakeCurve(*Curves, Curves->ReactionDelay, TEXT("ReactionDelay"), 0.0f, Table.ReactionDelayByLevel);
+    BakeCurve(*Curves, Curves->AimSpread, TEXT("AimSpread"), -UE_BIG_NUMBER, Table.AimSpreadByLevel);
+    BakeCurve(*Curves, Curves->FireRate, TEXT("FireRate"), MinFireRate, Table.FireRateByLevel);
+    BakeCurve(*Curves, Curves->BurstCount, TEXT("BurstCount"), 1.0f, Table.BurstCountByLevel);
+    BakeCurve(*Curves, Curves->PeekInterval, TEXT("PeekInterval"), 0.1f, Table.PeekIntervalByLevel);
+    Table.MinAimSpread = Curves->MinAimSpread;
+    Table.MaxAimSpread = FMath::Max(Curves->MinAimSpread, Curves->MaxAimSpread);
+    return Table;
+}
+
+const FGameDirectorDifficultyTable& FGameDirectorDifficultyTable::Default()
+{
+    static const FGameDirectorDifficultyTable Table = MakeDefaultTable();
+    return Table;
+}
@@ -0,0 +1,124 @@
+#include "GameDirectorEnemyRegistry.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+void UGameDirectorEnemyRegistry::Deinitialize()
+{
+    Enemies.Reset();
+    IndexByEnemy.Reset();
+    PositionsX.Reset();
+    PositionsY.Reset();
+    PositionsZ.Reset();
+
+    Super::Deinitialize();
+}
+
+void UGameDirectorEnemyRegistry::RegisterEnemy(AActor* Enemy)
+{
+    if (!Enemy || IndexByEnemy.Contains(Enemy))
+    {
+        return;
+    }
+
+    const FVector Location = Enemy->GetActorLocation();
+
+    IndexByEnemy.Add(Enemy, Enemies.Add(Enemy));
+    PositionsX.Add(static_cast<float>(Location.X));
+    PositionsY.Add(static_cast<float>(Location.Y));
+    PositionsZ.Add(static_cast<float>(Location.Z));
+}
+
+void UGameDirectorEnemyRegistry::UnregisterEnemy(AActor* Enemy)
+{
+    int32 Index = INDEX_NONE;
+    if (IndexByEnemy.RemoveAndCopyValue(Enemy, Index))
+    {
+        RemoveAtSwap(Index);
+    }
+}
+
+void UGameDirectorEnemyRegistry::RemoveAtSwap(int32 Index)
+{
+    const int32 LastIndex = Enemies.Num() - 1;
+    if (Index != LastIndex)
+    {
+        IndexByEnemy.FindChecked(Enemies[LastIndex]) = Index;
+    }
+
+    RemoveSlotAtSwap(Index);
+}
+
+void UGameDirectorEnemyRegistry::RemoveSlotAtSwap(int32 Index)
+{
+    Enemies.RemoveAtSwap(Index, EAllowShrinking::No);
+    PositionsX.RemoveAtSwap(Index, EAllowShrinking::No);
+    PositionsY.RemoveAtSwap(Index, EAllowShrinking::No);
+    PositionsZ.RemoveAtSwap(Index, EAllowShrinking::No);
+}
+
+void UGameDirectorEnemyRegistry::RefreshPositions()
+{
+    // Drop entries destroyed without EndPlay (e.g. garbage collected during a level transition). A collected entry
+    // reads as null and its map key can no longer be formed, so the map is rebuilt instead of patched.
+    bool bRemovedStale = false;
+    for (int32 Index = Enemies.Num() - 1; Index >= 0; --Index)
+    {
+        if (!IsValid(Enemies[Index]))
+        {
+            RemoveSlotAtSwap(Index);
+            bRemovedStale = true;
+        }
+    }
+
+    if (bRemovedStale)
+    {
+        IndexByEnemy.Reset();
+        for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+        {
+            IndexByEnemy.Add(Enemies[Index], Index);
+        }
+    }
+
+    for (int32 Index = 0; Index < Enemies.Num(); ++Index)
+    {
+        const FVector Location = Enemies[Index]->GetActorLocation();
+        PositionsX[Index] = static_cast<float>(Location.X);
+        PositionsY[Index] = static_cast<float>(Location.Y);
+        PositionsZ[Index] = static_cast<float>(Location.Z);
+    }
+}
+
+float UGameDirectorEnemyRegistry::ComputeAverageDistance(const FVector& Origin) const
+{
+    const int32 Count = PositionsX.Num();
+    if (Count == 0)
+    {
+        return 0.0f;
+    }
+
+    const float OriginX = static_cast<float>(Origin.X);
+    const float OriginY = static_cast<float>(Origin.Y);
+    const float OriginZ = static_cast<float>(Origin.Z);
+
+    const float* RESTRICT X = PositionsX.GetData();
+    const float* RESTRICT Y = PositionsY.GetData();
+    const float* RESTRICT Z = PositionsZ.GetData();
+
+    float DistanceSum = 0.0f;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const float DX = X[Index] - OriginX;
+        const float DY = Y[Index] - OriginY;
+        const float DZ = Z[Index] - OriginZ;
+        DistanceSum += FMath::Sqrt(DX * DX + DY * DY + DZ * DZ);
+    }
+
+    return DistanceSum / static_cast<float>(Count);
+}
+
+UGameDirectorEnemyRegistry* UGameDirectorEnemyRegistry::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGameDirectorEnemyRegistry>() : nullptr;
+}
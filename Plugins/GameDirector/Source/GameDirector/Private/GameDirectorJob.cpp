@@ -2,16 +2,20 @@
 
 FGameDirectorJob::FGameDirectorJob()
     : ComponentId(NAME_None)
-    , ScenarioJSON()
+    , ModelId(NAME_None)
+    , AdapterId(NAME_None)
+    , Scenario()
     , ResultJSON()
     , Priority(EPriority::Normal)
     , EnqueueTime(FDateTime::UtcNow())
 {
 }
 
-FGameDirectorJob::FGameDirectorJob(FName InComponentId, const FString& InScenarioJSON, EPriority InPriority)
+FGameDirectorJob::FGameDirectorJob(FName InComponentId, const FGameDirectorScenario& InScenario, EPriority InPriority)
     : ComponentId(InComponentId)
-    , ScenarioJSON(InScenarioJSON)
+    , ModelId(NAME_None)
+    , AdapterId(NAME_None)
+    , Scenario(InScenario)
     , ResultJSON()
     , Priority(InPriority)
     , EnqueueTime(FDateTime::UtcNow())
@@ -2,17 +2,28 @@
 
 #include "Algo/Sort.h"
 #include "Async/Async.h"
-#include "Async/TaskGraphInterfaces.h"
+#include "GameDirectorModelManager.h"
+#include "GameDirectorStats.h"
+#include "GameDirectorTrace.h"
+#include "HAL/PlatformTime.h"
 #include "LlamaRunner.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogGameDirectorJobs, Log, All);
 
-FGameDirectorJobQueue::FGameDirectorJobQueue(const TSharedPtr<FLlamaRunner>& InRunner, int32 InMaxConcurrentJobs)
+FGameDirectorJobQueue::FGameDirectorJobQueue(const TSharedPtr<ILlamaRunner>& InRunner, int32 InMaxConcurrentJobs)
     : LlamaRunner(InRunner)
     , MaxConcurrentJobs(FMath::Max(1, InMaxConcurrentJobs))
 {
 }
 
+FGameDirectorJobQueue::FGameDirectorJobQueue(const TSharedPtr<FGameDirectorModelManager>& InModelManager, FName InDefaultModelId, int32 InMaxConcurrentJobs)
+    : ModelManager(InModelManager)
+    , DefaultModelId(InDefaultModelId)
+    , MaxConcurrentJobs(FMath::Max(1, InMaxConcurrentJobs))
+{
+}
+
 void FGameDirectorJobQueue::EnqueueJob(const TSharedPtr<FGameDirectorJob>& Job)
 {
     if (!Job.IsValid())
@@ -22,6 +33,11 @@ void FGameDirectorJobQueue::EnqueueJob(const TSharedPtr<FGameDirectorJob>& Job)
     }
 
     Job->EnqueueTime = FDateTime::UtcNow();
+    Job->EnqueueSeconds = FPlatformTime::Seconds();
+    Job->JobId = FGameDirectorTrace::AllocateJobId();
+
+    TRACE_GAMEDIRECTOR_BEGIN_JOB(Job->JobId, Job->ComponentId);
+    TRACE_GAMEDIRECTOR_PHASE(Job->JobId, Enqueue, Job->ComponentId);
 
     {
         FScopeLock ScopeLock(&PendingMutex);
@@ -35,34 +51,94 @@ void FGameDirectorJobQueue::EnqueueJob(const TSharedPtr<FGameDirectorJob>& Job)
     TryStartJobs();
 }
 
+int32 FGameDirectorJobQueue::CancelJobs(FName ComponentId)
+{
+    TArray<TSharedPtr<FGameDirectorJob>> Cancelled;
+    {
+        FScopeLock ScopeLock(&PendingMutex);
+        for (int32 Index = PendingJobs.Num() - 1; Index >= 0; --Index)
+        {
+            if (PendingJobs[Index].IsValid() && PendingJobs[Index]->ComponentId == ComponentId)
+            {
+                Cancelled.Add(PendingJobs[Index]);
+                PendingJobs.RemoveAt(Index, EAllowShrinking::No);
+            }
+        }
+    }
+
+    for (const TSharedPtr<FGameDirectorJob>& Job : Cancelled)
+    {
+        TRACE_GAMEDIRECTOR_END_JOB(Job->JobId, Job->ComponentId);
+    }
+
+    if (Cancelled.Num() > 0)
+    {
+        UE_LOG(LogGameDirectorJobs, Log, TEXT("[GameDirectorJobQueue] Cancelled %d pending jobs for %s."), Cancelled.Num(), *ComponentId.ToString());
+    }
+
+    return Cancelled.Num();
+}
+
 void FGameDirectorJobQueue::Tick()
 {
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_QueueTick);
+
     TryStartJobs();
 
-    TArray<TSharedPtr<FGameDirectorJob>> JobsToDispatch;
-    TSharedPtr<FGameDirectorJob> Job;
-    while (CompletedJobs.Dequeue(Job))
     {
-        JobsToDispatch.Add(Job);
+        FScopeLock PendingLock(&PendingMutex);
+        SET_DWORD_STAT(STAT_GameDirector_PendingJobs, PendingJobs.Num());
     }
+    {
+        FScopeLock ActiveLock(&ActiveMutex);
+        SET_DWORD_STAT(STAT_GameDirector_ActiveJobs, ActiveJobCount);
+    }
+
+    DispatchCompletedJobs();
+}
 
-    for (const TSharedPtr<FGameDirectorJob>& Job : JobsToDispatch)
+void FGameDirectorJobQueue::DispatchCompletedJobs()
+{
+    check(IsInGameThread());
+
+    // Tick already runs on the game thread, so callbacks run inline rather than through another task-graph hop.
+    const double DispatchStart = FPlatformTime::Seconds();
+    int32 DispatchedCount = 0;
+
+    TSharedPtr<FGameDirectorJob> Job;
+    while (CompletedJobs.Dequeue(Job))
     {
         if (!Job.IsValid())
         {
             continue;
         }
 
-        UE_LOG(LogGameDirectorJobs, Log, TEXT("[GameDirectorJobQueue] Dispatching completed job for %s."),
+        UE_LOG(LogGameDirectorJobs, Verbose, TEXT("[GameDirectorJobQueue] Dispatching completed job for %s."),
             *Job->ComponentId.ToString());
 
-        AsyncTask(ENamedThreads::GameThread, [Job]()
+        TRACE_GAMEDIRECTOR_PHASE(Job->JobId, Dispatch, Job->ComponentId);
         {
+            TRACE_GAMEDIRECTOR_JOB_SCOPE(Job->JobId);
+
             if (Job->OnComplete)
             {
                 Job->OnComplete(Job->ResultJSON);
             }
-        });
+        }
+        TRACE_GAMEDIRECTOR_END_JOB(Job->JobId, Job->ComponentId);
+
+        ++DispatchedCount;
+
+        if (DispatchBudgetSeconds > 0.0 && FPlatformTime::Seconds() - DispatchStart >= DispatchBudgetSeconds)
+        {
+            if (!CompletedJobs.IsEmpty())
+            {
+                UE_LOG(LogGameDirectorJobs, Verbose,
+                    TEXT("[GameDirectorJobQueue] Dispatch budget spent after %d jobs; deferring the rest to the next tick."),
+                    DispatchedCount);
+            }
+            break;
+        }
     }
 }
 
@@ -129,7 +205,13 @@ void FGameDirectorJobQueue::StartJob(const TSharedPtr<FGameDirectorJob>& Job)
 
     Async(EAsyncExecution::ThreadPool, [ThisPtr, Job]()
     {
-        const TSharedPtr<FLlamaRunner> Runner = ThisPtr->LlamaRunner.Pin();
+        TRACE_CPUPROFILER_EVENT_SCOPE(GameDirector_Job);
+        TRACE_GAMEDIRECTOR_JOB_SCOPE(Job->JobId);
+        TRACE_GAMEDIRECTOR_PHASE(Job->JobId, Start, Job->ComponentId);
+
+        Job->QueueWaitMs = (FPlatformTime::Seconds() - Job->EnqueueSeconds) * 1000.0;
+
+        const TSharedPtr<ILlamaRunner> Runner = ThisPtr->ResolveRunner(*Job);
         if (!Runner.IsValid())
         {
             UE_LOG(LogGameDirectorJobs, Warning,
@@ -139,14 +221,28 @@ void FGameDirectorJobQueue::StartJob(const TSharedPtr<FGameDirectorJob>& Job)
             return;
         }
 
-        Job->ResultJSON = Runner->RunInference(Job->ScenarioJSON);
+        Job->ResultJSON = Runner->RunInference(Job->Scenario, Job->AdapterId, &Job->InferenceStats);
+
+        FGameDirectorStats::Get().RecordJob(Job->QueueWaitMs, Job->InferenceStats);
 
-        UE_LOG(LogGameDirectorJobs, Log, TEXT("[GameDirectorJobQueue] Job completed for %s."), *Job->ComponentId.ToString());
+        UE_LOG(LogGameDirectorJobs, Log, TEXT("[GameDirectorJobQueue] Job completed for %s (queue %.1f ms, inference %.1f ms, ttft %.1f ms)."),
+            *Job->ComponentId.ToString(), Job->QueueWaitMs, Job->InferenceStats.TotalMs, Job->InferenceStats.TimeToFirstTokenMs);
 
         ThisPtr->CompleteJob(Job);
     });
 }
 
+TSharedPtr<ILlamaRunner> FGameDirectorJobQueue::ResolveRunner(const FGameDirectorJob& Job) const
+{
+    if (const TSharedPtr<FGameDirectorModelManager> Manager = ModelManager.Pin())
+    {
+        // May load the model (and evict others) on this worker thread.
+        return Manager->AcquireRunner(Job.ModelId.IsNone() ? DefaultModelId : Job.ModelId);
+    }
+
+    return LlamaRunner.Pin();
+}
+
 void FGameDirectorJobQueue::CompleteJob(const TSharedPtr<FGameDirectorJob>& Job)
 {
     {
@@ -154,5 +250,7 @@ void FGameDirectorJobQueue::CompleteJob(const TSharedPtr<FGameDirectorJob>& Job)
         ActiveJobCount = FMath::Max(0, ActiveJobCount - 1);
     }
 
+    TRACE_GAMEDIRECTOR_PHASE(Job->JobId, Complete, Job->ComponentId);
+
     CompletedJobs.Enqueue(Job);
 }
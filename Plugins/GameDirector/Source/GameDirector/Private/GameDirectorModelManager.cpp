@@ -0,0 +1,557 @@
+#include "GameDirectorModelManager.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "LlamaRunner.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameDirectorModels, Log, All);
+
+namespace
+{
+    struct FQuantizationTag
+    {
+        const TCHAR* Tag;
+        llama_ftype FileType;
+    };
+
+    // Longest tags first so "Q4_K_M" is not mistaken for a shorter match.
+    const FQuantizationTag kQuantizationTags[] =
+    {
+        { TEXT("Q3_K_S"), LLAMA_FTYPE_MOSTLY_Q3_K_S },
+        { TEXT("Q3_K_M"), LLAMA_FTYPE_MOSTLY_Q3_K_M },
+        { TEXT("Q3_K_L"), LLAMA_FTYPE_MOSTLY_Q3_K_L },
+        { TEXT("Q4_K_S"), LLAMA_FTYPE_MOSTLY_Q4_K_S },
+        { TEXT("Q4_K_M"), LLAMA_FTYPE_MOSTLY_Q4_K_M },
+        { TEXT("Q5_K_S"), LLAMA_FTYPE_MOSTLY_Q5_K_S },
+        { TEXT("Q5_K_M"), LLAMA_FTYPE_MOSTLY_Q5_K_M },
+        { TEXT("IQ4_XS"), LLAMA_FTYPE_MOSTLY_IQ4_XS },
+        { TEXT("IQ4_NL"), LLAMA_FTYPE_MOSTLY_IQ4_NL },
+        { TEXT("Q2_K"), LLAMA_FTYPE_MOSTLY_Q2_K },
+        { TEXT("Q4_0"), LLAMA_FTYPE_MOSTLY_Q4_0 },
+        { TEXT("Q4_1"), LLAMA_FTYPE_MOSTLY_Q4_1 },
+        { TEXT("Q4_K"), LLAMA_FTYPE_MOSTLY_Q4_K_M },
+        { TEXT("Q5_0"), LLAMA_FTYPE_MOSTLY_Q5_0 },
+        { TEXT("Q5_1"), LLAMA_FTYPE_MOSTLY_Q5_1 },
+        { TEXT("Q5_K"), LLAMA_FTYPE_MOSTLY_Q5_K_M },
+        { TEXT("Q6_K"), LLAMA_FTYPE_MOSTLY_Q6_K },
+        { TEXT("Q8_0"), LLAMA_FTYPE_MOSTLY_Q8_0 },
+        { TEXT("BF16"), LLAMA_FTYPE_MOSTLY_BF16 },
+        { TEXT("F16"), LLAMA_FTYPE_MOSTLY_F16 },
+        { TEXT("F32"), LLAMA_FTYPE_ALL_F32 },
+    };
+
+    double EstimateDecodeMsPerToken(uint64 ModelBytes, float MemoryBandwidthGBps)
+    {
+        return MemoryBandwidthGBps > 0.0f ? (ModelBytes / (MemoryBandwidthGBps * 1.0e9)) * 1000.0 : 0.0;
+    }
+
+    FString NormalizeModelPath(const FString& ModelPath)
+    {
+        FString Normalized = FPaths::ConvertRelativePathToFull(ModelPath);
+        FPaths::NormalizeFilename(Normalized);
+        return Normalized;
+    }
+}
+
+FGameDirectorModelManager::FGameDirectorModelManager(uint64 InMemoryBudgetBytes)
+    : MemoryBudgetBytes(InMemoryBudgetBytes)
+{
+}
+
+FGameDirectorModelManager::~FGameDirectorModelManager()
+{
+    EvictAll();
+}
+
+int32 FGameDirectorModelManager::DiscoverModels(const FString& ModelsDirectory)
+{
+    if (!FPaths::DirectoryExists(ModelsDirectory))
+    {
+        return 0;
+    }
+
+    TArray<FString> FoundModels;
+    IFileManager::Get().FindFiles(FoundModels, *(ModelsDirectory / TEXT("*.gguf")), true, false);
+    FoundModels.Sort();
+
+    for (const FString& ModelFile : FoundModels)
+    {
+        RegisterModel(FName(*FPaths::GetBaseFilename(ModelFile)), FPaths::Combine(ModelsDirectory, ModelFile));
+    }
+
+    return FoundModels.Num();
+}
+
+void FGameDirectorModelManager::RegisterModel(FName ModelId, const FString& ModelPath)
+{
+    if (ModelId.IsNone() || ModelPath.IsEmpty())
+    {
+        return;
+    }
+
+    FScopeLock Lock(&Mutex);
+    ModelPaths.Add(ModelId, NormalizeModelPath(ModelPath));
+
+    UE_LOG(LogGameDirectorModels, Verbose, TEXT("[ModelManager] Registered model %s -> %s"), *ModelId.ToString(), *ModelPath);
+}
+
+void FGameDirectorModelManager::RegisterAdapter(FName ModelId, FName AdapterId, const FString& AdapterPath)
+{
+    if (AdapterId.IsNone() || AdapterPath.IsEmpty())
+    {
+        return;
+    }
+
+    TSharedPtr<FLlamaRunner> ResidentRunner;
+    {
+        FScopeLock Lock(&Mutex);
+
+        const FString* ModelPath = ModelPaths.Find(ModelId);
+        if (!ModelPath)
+        {
+            UE_LOG(LogGameDirectorModels, Warning, TEXT("[ModelManager] Cannot register adapter %s for unknown model %s."),
+                *AdapterId.ToString(), *ModelId.ToString());
+            return;
+        }
+
+        AdapterPaths.FindOrAdd(*ModelPath).Add(AdapterId, NormalizeModelPath(AdapterPath));
+
+        if (const FResidentModel* Resident = ResidentModels.Find(*ModelPath))
+        {
+            ResidentRunner = Resident->Runner;
+        }
+    }
+
+    // Adapters registered after the model became resident are attached right away.
+    if (ResidentRunner.IsValid())
+    {
+        ResidentRunner->LoadAdapter(AdapterId, AdapterPath);
+    }
+}
+
+int32 FGameDirectorModelManager::DiscoverAdapters(FName ModelId, const FString& AdaptersDirectory)
+{
+    if (!FPaths::DirectoryExists(AdaptersDirectory))
+    {
+        return 0;
+    }
+
+    TArray<FString> FoundAdapters;
+    IFileManager::Get().FindFiles(FoundAdapters, *(AdaptersDirectory / TEXT("*.gguf")), true, false);
+
+    for (const FString& AdapterFile : FoundAdapters)
+    {
+        RegisterAdapter(ModelId, FName(*FPaths::GetBaseFilename(AdapterFile)), FPaths::Combine(AdaptersDirectory, AdapterFile));
+    }
+
+    return FoundAdapters.Num();
+}
+
+bool FGameDirectorModelManager::HasAdapter(FName ModelId, FName AdapterId) const
+{
+    FScopeLock Lock(&Mutex);
+
+    const FString* ModelPath = ModelPaths.Find(ModelId);
+    const TMap<FName, FString>* Adapters = ModelPath ? AdapterPaths.Find(*ModelPath) : nullptr;
+    return Adapters && Adapters->Contains(AdapterId);
+}
+
+TSharedPtr<FLlamaRunner> FGameDirectorModelManager::AcquireRunner(FName ModelId)
+{
+    FString ModelPath;
+    TPromise<void> LoadedPromise;
+
+    for (;;)
+    {
+        TSharedFuture<void> PendingLoad;
+        {
+            FScopeLock Lock(&Mutex);
+
+            const FString* FoundPath = ModelPaths.Find(ModelId);
+            if (!FoundPath)
+            {
+                UE_LOG(LogGameDirectorModels, Warning, TEXT("[ModelManager] Unknown model id %s."), *ModelId.ToString());
+                return nullptr;
+            }
+
+            ModelPath = *FoundPath;
+
+            FResidentModel* Resident = ResidentModels.Find(ModelPath);
+            if (!Resident)
+            {
+                // Reserve the file size up front so concurrent loads cannot overshoot the budget.
+                const uint64 EstimatedBytes = static_cast<uint64>(FMath::Max<int64>(IFileManager::Get().FileSize(*ModelPath), 0));
+                EvictToFit(EstimatedBytes, ModelPath);
+
+                FResidentModel& NewEntry = ResidentModels.Add(ModelPath);
+                NewEntry.SizeBytes = EstimatedBytes;
+                NewEntry.LastUsedTime = FPlatformTime::Seconds();
+                NewEntry.bLoading = true;
+                NewEntry.Loaded = LoadedPromise.GetFuture().Share();
+                ResidentBytes += EstimatedBytes;
+                break;
+            }
+
+            if (!Resident->bLoading)
+            {
+                Resident->LastUsedTime = FPlatformTime::Seconds();
+                return Resident->Runner;
+            }
+
+            PendingLoad = Resident->Loaded;
+        }
+
+        // Another thread is loading the same file; wait for it instead of mapping the weights twice, then look the
+        // entry up again since the load may have failed or been evicted meanwhile.
+        PendingLoad.Wait();
+    }
+
+    UE_LOG(LogGameDirectorModels, Log, TEXT("[ModelManager] Loading model %s from %s"), *ModelId.ToString(), *ModelPath);
+
+    const TSharedPtr<FLlamaRunner> Runner = MakeShared<FLlamaRunner>();
+    const bool bLoaded = Runner->LoadModel(ModelPath);
+
+    if (bLoaded)
+    {
+        TMap<FName, FString> Adapters;
+        {
+            FScopeLock Lock(&Mutex);
+            if (const TMap<FName, FString>* Registered = AdapterPaths.Find(ModelPath))
+            {
+                Adapters = *Registered;
+            }
+        }
+
+        // LoRA adapters only add megabytes on top of the shared base weights.
+        for (const TPair<FName, FString>& Adapter : Adapters)
+        {
+            Runner->LoadAdapter(Adapter.Key, Adapter.Value);
+        }
+    }
+
+    FScopeLock Lock(&Mutex);
+
+    // Wakes waiters on every path out of here; they look the entry up again once the lock is released.
+    ON_SCOPE_EXIT { LoadedPromise.SetValue(); };
+
+    FResidentModel* Resident = ResidentModels.Find(ModelPath);
+    check(Resident);
+
+    ResidentBytes -= Resident->SizeBytes;
+
+    if (!bLoaded)
+    {
+        UE_LOG(LogGameDirectorModels, Error, TEXT("[ModelManager] Failed to load model %s."), *ModelId.ToString());
+        ResidentModels.Remove(ModelPath);
+        return nullptr;
+    }
+
+    Resident->Runner = Runner;
+    Resident->SizeBytes = Runner->GetModelSizeBytes();
+    Resident->LastUsedTime = FPlatformTime::Seconds();
+    Resident->bLoading = false;
+    ResidentBytes += Resident->SizeBytes;
+
+    UE_LOG(LogGameDirectorModels, Log, TEXT("[ModelManager] Model %s resident (%.1f MB, total %.1f / %.1f MB)."),
+        *ModelId.ToString(),
+        Resident->SizeBytes / (1024.0 * 1024.0),
+        ResidentBytes / (1024.0 * 1024.0),
+        MemoryBudgetBytes / (1024.0 * 1024.0));
+
+    EvictToFit(0, ModelPath);
+
+    return Runner;
+}
+
+void FGameDirectorModelManager::Prefetch(FName ModelId)
+{
+    if (IsResident(ModelId))
+    {
+        return;
+    }
+
+    const TWeakPtr<FGameDirectorModelManager> WeakThis = AsShared();
+
+    Async(EAsyncExecution::ThreadPool, [WeakThis, ModelId]()
+    {
+        if (const TSharedPtr<FGameDirectorModelManager> Manager = WeakThis.Pin())
+        {
+            Manager->AcquireRunner(ModelId);
+        }
+    });
+}
+
+void FGameDirectorModelManager::Evict(FName ModelId)
+{
+    FScopeLock Lock(&Mutex);
+
+    if (const FString* ModelPath = ModelPaths.Find(ModelId))
+    {
+        EvictPath(*ModelPath);
+    }
+}
+
+void FGameDirectorModelManager::EvictAll()
+{
+    FScopeLock Lock(&Mutex);
+
+    TArray<FString> Paths;
+    ResidentModels.GetKeys(Paths);
+
+    for (const FString& ModelPath : Paths)
+    {
+        EvictPath(ModelPath);
+    }
+}
+
+void FGameDirectorModelManager::SetMemoryBudget(uint64 InMemoryBudgetBytes)
+{
+    FScopeLock Lock(&Mutex);
+    MemoryBudgetBytes = InMemoryBudgetBytes;
+    EvictToFit(0, FString());
+}
+
+uint64 FGameDirectorModelManager::GetMemoryBudget() const
+{
+    FScopeLock Lock(&Mutex);
+    return MemoryBudgetBytes;
+}
+
+uint64 FGameDirectorModelManager::GetResidentBytes() const
+{
+    FScopeLock Lock(&Mutex);
+
+    uint64 Bytes = ResidentBytes;
+    for (const FRetiredModel& Retired : RetiredModels)
+    {
+        if (!Retired.Runner.IsValid())
+        {
+            Bytes -= FMath::Min(Bytes, Retired.SizeBytes);
+        }
+    }
+    return Bytes;
+}
+
+bool FGameDirectorModelManager::IsRegistered(FName ModelId) const
+{
+    FScopeLock Lock(&Mutex);
+    return ModelPaths.Contains(ModelId);
+}
+
+bool FGameDirectorModelManager::IsResident(FName ModelId) const
+{
+    FScopeLock Lock(&Mutex);
+
+    const FString* ModelPath = ModelPaths.Find(ModelId);
+    if (!ModelPath)
+    {
+        return false;
+    }
+
+    const FResidentModel* Resident = ResidentModels.Find(*ModelPath);
+    return Resident && !Resident->bLoading;
+}
+
+TArray<FName> FGameDirectorModelManager::GetRegisteredModels() const
+{
+    FScopeLock Lock(&Mutex);
+
+    TArray<FName> ModelIds;
+    ModelPaths.GetKeys(ModelIds);
+    ModelIds.Sort(FNameLexicalLess());
+    return ModelIds;
+}
+
+FString FGameDirectorModelManager::GetModelPath(FName ModelId) const
+{
+    FScopeLock Lock(&Mutex);
+
+    const FString* ModelPath = ModelPaths.Find(ModelId);
+    return ModelPath ? *ModelPath : FString();
+}
+
+TArray<FGameDirectorModelVariant> FGameDirectorModelManager::GetVariants(const FString& BaseName) const
+{
+    TArray<FGameDirectorModelVariant> Variants;
+
+    {
+        FScopeLock Lock(&Mutex);
+
+        for (const TPair<FName, FString>& Pair : ModelPaths)
+        {
+            FGameDirectorModelVariant Variant;
+            Variant.ModelId = Pair.Key;
+            SplitModelName(Pair.Key.ToString(), Variant.BaseName, Variant.Quantization);
+
+            if (!BaseName.IsEmpty() && !Variant.BaseName.Equals(BaseName, ESearchCase::IgnoreCase))
+            {
+                continue;
+            }
+
+            Variant.FileSizeBytes = static_cast<uint64>(FMath::Max<int64>(IFileManager::Get().FileSize(*Pair.Value), 0));
+            Variants.Add(MoveTemp(Variant));
+        }
+    }
+
+    Variants.Sort([](const FGameDirectorModelVariant& Lhs, const FGameDirectorModelVariant& Rhs)
+    {
+        return Lhs.FileSizeBytes > Rhs.FileSizeBytes;
+    });
+
+    return Variants;
+}
+
+FName FGameDirectorModelManager::SelectVariant(const FString& BaseName, const FGameDirectorModelBudget& Budget) const
+{
+    const TArray<FGameDirectorModelVariant> Variants = GetVariants(BaseName);
+    if (Variants.Num() == 0)
+    {
+        return NAME_None;
+    }
+
+    // Variants are ordered largest first, which for one base model means highest precision first.
+    for (const FGameDirectorModelVariant& Variant : Variants)
+    {
+        const bool bFitsMemory = Budget.MaxModelBytes == 0 || Variant.FileSizeBytes <= Budget.MaxModelBytes;
+        const double DecodeMs = EstimateDecodeMsPerToken(Variant.FileSizeBytes, Budget.MemoryBandwidthGBps);
+        const bool bFitsLatency = Budget.MaxDecodeMsPerToken <= 0.0f || DecodeMs <= Budget.MaxDecodeMsPerToken;
+
+        if (bFitsMemory && bFitsLatency)
+        {
+            UE_LOG(LogGameDirectorModels, Log, TEXT("[ModelManager] Selected %s (%s, %.1f MB, ~%.1f ms/token) for %s."),
+                *Variant.ModelId.ToString(),
+                Variant.Quantization.IsEmpty() ? TEXT("untagged") : *Variant.Quantization,
+                Variant.FileSizeBytes / (1024.0 * 1024.0),
+                DecodeMs,
+                BaseName.IsEmpty() ? TEXT("any model") : *BaseName);
+            return Variant.ModelId;
+        }
+    }
+
+    const FGameDirectorModelVariant& Smallest = Variants.Last();
+    UE_LOG(LogGameDirectorModels, Warning, TEXT("[ModelManager] No variant of %s fits the budget; falling back to the smallest (%s, %.1f MB)."),
+        BaseName.IsEmpty() ? TEXT("any model") : *BaseName,
+        *Smallest.ModelId.ToString(),
+        Smallest.FileSizeBytes / (1024.0 * 1024.0));
+    return Smallest.ModelId;
+}
+
+void FGameDirectorModelManager::SplitModelName(const FString& FileBaseName, FString& OutBaseName, FString& OutQuantization)
+{
+    OutBaseName = FileBaseName;
+    OutQuantization.Reset();
+
+    const FString UpperName = FileBaseName.ToUpper();
+
+    for (const FQuantizationTag& Entry : kQuantizationTags)
+    {
+        const int32 TagLength = FCString::Strlen(Entry.Tag);
+        if (UpperName.Len() <= TagLength || !UpperName.EndsWith(Entry.Tag, ESearchCase::CaseSensitive))
+        {
+            continue;
+        }
+
+        const TCHAR Separator = UpperName[UpperName.Len() - TagLength - 1];
+        if (Separator != TEXT('.') && Separator != TEXT('-') && Separator != TEXT('_'))
+        {
+            continue;
+        }
+
+        OutQuantization = Entry.Tag;
+        OutBaseName = FileBaseName.Left(FileBaseName.Len() - TagLength - 1);
+        return;
+    }
+}
+
+int32 FGameDirectorModelManager::GetQuantizationFileType(const FString& Quantization)
+{
+    for (const FQuantizationTag& Entry : kQuantizationTags)
+    {
+        if (Quantization.Equals(Entry.Tag, ESearchCase::IgnoreCase))
+        {
+            return static_cast<int32>(Entry.FileType);
+        }
+    }
+
+    return INDEX_NONE;
+}
+
+void FGameDirectorModelManager::EvictToFit(uint64 IncomingBytes, const FString& KeepPath)
+{
+    PurgeReleasedModels();
+
+    if (MemoryBudgetBytes == 0)
+    {
+        return;
+    }
+
+    while (ResidentBytes + IncomingBytes > MemoryBudgetBytes)
+    {
+        const FString* OldestPath = nullptr;
+        double OldestTime = TNumericLimits<double>::Max();
+
+        for (const TPair<FString, FResidentModel>& Pair : ResidentModels)
+        {
+            if (Pair.Value.bLoading || Pair.Key == KeepPath)
+            {
+                continue;
+            }
+
+            if (Pair.Value.LastUsedTime < OldestTime)
+            {
+                OldestTime = Pair.Value.LastUsedTime;
+                OldestPath = &Pair.Key;
+            }
+        }
+
+        if (!OldestPath)
+        {
+            UE_LOG(LogGameDirectorModels, Warning,
+                TEXT("[ModelManager] Resident models (%.1f MB + %.1f MB incoming) exceed the %.1f MB budget and nothing else can be evicted."),
+                ResidentBytes / (1024.0 * 1024.0),
+                IncomingBytes / (1024.0 * 1024.0),
+                MemoryBudgetBytes / (1024.0 * 1024.0));
+            return;
+        }
+
+        EvictPath(FString(*OldestPath));
+    }
+}
+
+void FGameDirectorModelManager::EvictPath(const FString& ModelPath)
+{
+    FResidentModel* Resident = ResidentModels.Find(ModelPath);
+    if (!Resident || Resident->bLoading)
+    {
+        return;
+    }
+
+    UE_LOG(LogGameDirectorModels, Log, TEXT("[ModelManager] Evicting %s (%.1f MB)."), *ModelPath, Resident->SizeBytes / (1024.0 * 1024.0));
+
+    // The weights are only unmapped once the last job holding the runner finishes.
+    if (Resident->Runner.IsValid() && !Resident->Runner.IsUnique())
+    {
+        RetiredModels.Add({ Resident->Runner, Resident->SizeBytes });
+    }
+    else
+    {
+        ResidentBytes -= FMath::Min(ResidentBytes, Resident->SizeBytes);
+    }
+
+    ResidentModels.Remove(ModelPath);
+}
+
+void FGameDirectorModelManager::PurgeReleasedModels()
+{
+    for (int32 Index = RetiredModels.Num() - 1; Index >= 0; --Index)
+    {
+        if (!RetiredModels[Index].Runner.IsValid())
+        {
+            ResidentBytes -= FMath::Min(ResidentBytes, RetiredModels[Index].SizeBytes);
+            RetiredModels.RemoveAtSwap(Index, EAllowShrinking::No);
+        }
+    }
+}
@@ -0,0 +1,450 @@
+#include "GameDirectorPolicy.h"
+
+#include "GameDirectorStats.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameDirectorPolicy, Log, All);
+
+namespace
+{
+    const TCHAR* kPolicySchema = TEXT("gda.policy.v1");
+
+    const TCHAR* const kOutputNames[] = { TEXT("aim_spread_level"), TEXT("reaction_level"), TEXT("aggression_level"), TEXT("peek_level"), TEXT("duration_s") };
+
+    float Gini(const TMap<int32, int32>& Counts, int32 Total)
+    {
+        if (Total <= 0)
+        {
+            return 0.0f;
+        }
+
+        float SumSquares = 0.0f;
+        for (const TPair<int32, int32>& Pair : Counts)
+        {
+            const float Fraction = static_cast<float>(Pair.Value) / Total;
+            SumSquares += Fraction * Fraction;
+        }
+        return 1.0f - SumSquares;
+    }
+}
+
+const TCHAR* FGameDirectorPolicy::GetOutputName(EOutput Output)
+{
+    const int32 Index = static_cast<int32>(Output);
+    return Index < UE_ARRAY_COUNT(kOutputNames) ? kOutputNames[Index] : TEXT("");
+}
+
+int32 FGameDirectorPolicy::GetOutputValue(const FAIDifficulty& Decision, EOutput Output)
+{
+    switch (Output)
+    {
+    case EOutput::AimSpreadLevel:   return Decision.AimSpreadLevel;
+    case EOutput::ReactionLevel:    return Decision.ReactionLevel;
+    case EOutput::AggressionLevel:  return Decision.AggressionLevel;
+    case EOutput::PeekLevel:        return Decision.PeekLevel;
+    case EOutput::DurationS:        return Decision.DurationS;
+    default:                        return 0;
+    }
+}
+
+void FGameDirectorPolicy::GetFeatures(const FGameDirectorScenario& Scenario, FFeatures& OutFeatures)
+{
+    for (int32 Index = 0; Index < NumFeatures; ++Index)
+    {
+        // Telemetry and load fields read as -1 when the scenario has none, which the trees can split on like any value.
+        const FGameDirectorScenario::ECompactField Field = static_cast<FGameDirectorScenario::ECompactField>(Index);
+        OutFeatures[Index] = Scenario.HasCompactField(Field) ? Scenario.GetCompactValue(Field) : -1;
+    }
+}
+
+const FGameDirectorPolicy::FNode& FGameDirectorPolicy::FindLeaf(EOutput Output, const FFeatures& Features) const
+{
+    const TArray<FNode>& Tree = Trees[static_cast<int32>(Output)];
+
+    int32 NodeIndex = 0;
+    while (Tree[NodeIndex].Feature != INDEX_NONE)
+    {
+        const FNode& Node = Tree[NodeIndex];
+        NodeIndex = Features[Node.Feature] <= Node.Threshold ? Node.Left : Node.Right;
+    }
+    return Tree[NodeIndex];
+}
+
+bool FGameDirectorPolicy::Predict(const FGameDirectorScenario& Scenario, FAIDifficulty& OutDecision, float& OutConfidence) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_Policy);
+
+    if (!IsValid())
+    {
+        return false;
+    }
+
+    FFeatures Features;
+    GetFeatures(Scenario, Features);
+
+    OutConfidence = 1.0f;
+    for (int32 OutputIndex = 0; OutputIndex < NumOutputs; ++OutputIndex)
+    {
+        const EOutput Output = static_cast<EOutput>(OutputIndex);
+        const FNode& Leaf = FindLeaf(Output, Features);
+        OutConfidence = FMath::Min(OutConfidence, Leaf.Confidence);
+
+        switch (Output)
+        {
+        case EOutput::AimSpreadLevel:
+            OutDecision.AimSpreadLevel = Leaf.Value;
+            OutDecision.AimSpreadFine = Leaf.MeanFine;
+            break;
+        case EOutput::ReactionLevel:    OutDecision.ReactionLevel = Leaf.Value; break;
+        case EOutput::AggressionLevel:  OutDecision.AggressionLevel = Leaf.Value; break;
+        case EOutput::PeekLevel:        OutDecision.PeekLevel = Leaf.Value; break;
+        case EOutput::DurationS:        OutDecision.DurationS = Leaf.Value; break;
+        default:                        break;
+        }
+    }
+
+    return true;
+}
+
+void FGameDirectorPolicy::Train(TConstArrayView<FGameDirectorPolicySample> Samples, const FTrainingSettings& Settings)
+{
+    NumTrainingSamples = 0;
+    for (TArray<FNode>& Tree : Trees)
+    {
+        Tree.Reset();
+    }
+
+    if (Samples.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<FFeatures> Features;
+    Features.SetNum(Samples.Num());
+    for (int32 Index = 0; Index < Samples.Num(); ++Index)
+    {
+        GetFeatures(Samples[Index].Scenario, Features[Index]);
+    }
+
+    for (int32 OutputIndex = 0; OutputIndex < NumOutputs; ++OutputIndex)
+    {
+        TArray<int32> Indices;
+        Indices.Reserve(Samples.Num());
+        for (int32 Index = 0; Index < Samples.Num(); ++Index)
+        {
+            Indices.Add(Index);
+        }
+
+        BuildNode(static_cast<EOutput>(OutputIndex), Features, Samples, Indices, 0, Settings);
+    }
+
+    NumTrainingSamples = Samples.Num();
+}
+
+int32 FGameDirectorPolicy::BuildNode(EOutput Output, const TArray<FFeatures>& Features, TConstArrayView<FGameDirectorPolicySample> Samples,
+    TArray<int32>& Indices, int32 Depth, const FTrainingSettings& Settings)
+{
+    TArray<FNode>& Tree = Trees[static_cast<int32>(Output)];
+    const int32 NodeIndex = Tree.AddDefaulted();
+    const int32 Total = Indices.Num();
+
+    //--- Leaf statistics ------------------------------------------------------
+    TMap<int32, int32> Counts;
+    double FineSum = 0.0;
+    for (const int32 SampleIndex : Indices)
+    {
+        ++Counts.FindOrAdd(GetOutputValue(Samples[SampleIndex].Decision, Output));
+        FineSum += Samples[SampleIndex].Decision.AimSpreadFine;
+    }
+
+    int32 MajorityValue = 0;
+    int32 MajorityCount = 0;
+    for (const TPair<int32, int32>& Pair : Counts)
+    {
+        if (Pair.Value > MajorityCount || (Pair.Value == MajorityCount && Pair.Key < MajorityValue))
+        {
+            MajorityValue = Pair.Key;
+            MajorityCount = Pair.Value;
+        }
+    }
+
+    Tree[NodeIndex].Value = MajorityValue;
+    Tree[NodeIndex].Confidence = static_cast<float>(MajorityCount) / (Total + 1);
+    Tree[NodeIndex].MeanFine = Total > 0 ? static_cast<float>(FineSum / Total) : 0.0f;
+
+    if (Depth >= Settings.MaxDepth || Total < 2 * Settings.MinSamplesPerLeaf || Counts.Num() <= 1)
+    {
+        return NodeIndex;
+    }
+
+    //--- Best split -----------------------------------------------------------
+    const float ParentGini = Gini(Counts, Total);
+    float BestGini = ParentGini - KINDA_SMALL_NUMBER;
+    int32 BestFeature = INDEX_NONE;
+    float BestThreshold = 0.0f;
+
+    TArray<int32> Sorted = Indices;
+    TMap<int32, int32> LeftCounts;
+    TMap<int32, int32> RightCounts;
+
+    for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+    {
+        Sorted.Sort([&Features, Feature](int32 A, int32 B) { return Features[A][Feature] < Features[B][Feature]; });
+
+        LeftCounts.Reset();
+        RightCounts = Counts;
+
+        for (int32 Position = 0; Position < Total - 1; ++Position)
+        {
+            const int32 Value = GetOutputValue(Samples[Sorted[Position]].Decision, Output);
+            ++LeftCounts.FindOrAdd(Value);
+            --RightCounts.FindChecked(Value);
+
+            const int32 Current = Features[Sorted[Position]][Feature];
+            const int32 Next = Features[Sorted[Position + 1]][Feature];
+            const int32 NumLeft = Position + 1;
+            const int32 NumRight = Total - NumLeft;
+
+            if (Current == Next || NumLeft < Settings.MinSamplesPerLeaf || NumRight < Settings.MinSamplesPerLeaf)
+            {
+                continue;
+            }
+
+            const float SplitGini = (NumLeft * Gini(LeftCounts, NumLeft) + NumRight * Gini(RightCounts, NumRight)) / Total;
+            if (SplitGini < BestGini)
+            {
+                BestGini = SplitGini;
+                BestFeature = Feature;
+                BestThreshold = 0.5f * (Current + Next);
+            }
+        }
+    }
+
+    if (BestFeature == INDEX_NONE)
+    {
+        return NodeIndex;
+    }
+
+    //--- Recurse --------------------------------------------------------------
+    TArray<int32> LeftIndices;
+    TArray<int32> RightIndices;
+    for (const int32 SampleIndex : Indices)
+    {
+        (Features[SampleIndex][BestFeature] <= BestThreshold ? LeftIndices : RightIndices).Add(SampleIndex);
+    }
+
+    const int32 Left = BuildNode(Output, Features, Samples, LeftIndices, Depth + 1, Settings);
+    const int32 Right = BuildNode(Output, Features, Samples, RightIndices, Depth + 1, Settings);
+
+    // Tree may have reallocated while recursing.
+    FNode& Node = Trees[static_cast<int32>(Output)][NodeIndex];
+    Node.Feature = BestFeature;
+    Node.Threshold = BestThreshold;
+    Node.Left = Left;
+    Node.Right = Right;
+    return NodeIndex;
+}
+
+bool FGameDirectorPolicy::Save(const FString& FilePath) const
+{
+    const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("schema"), kPolicySchema);
+    Root->SetNumberField(TEXT("samples"), NumTrainingSamples);
+
+    TArray<TSharedPtr<FJsonValue>> FeatureNames;
+    for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+    {
+        FeatureNames.Add(MakeShared<FJsonValueString>(ANSI_TO_TCHAR(FGameDirectorScenario::GetCompactKey(static_cast<FGameDirectorScenario::ECompactField>(Feature)))));
+    }
+    Root->SetArrayField(TEXT("features"), FeatureNames);
+
+    // Nodes are stored as [feature, threshold, left, right, value, confidence, mean_fine].
+    const TSharedRef<FJsonObject> TreesObject = MakeShared<FJsonObject>();
+    for (int32 OutputIndex = 0; OutputIndex < NumOutputs; ++OutputIndex)
+    {
+        TArray<TSharedPtr<FJsonValue>> Nodes;
+        for (const FNode& Node : Trees[OutputIndex])
+        {
+            TArray<TSharedPtr<FJsonValue>> Fields;
+            Fields.Add(MakeShared<FJsonValueNumber>(Node.Feature));
+            Fields.Add(MakeShared<FJsonValueNumber>(Node.Threshold));
+            Fields.Add(MakeShared<FJsonValueNumber>(Node.Left));
+            Fields.Add(MakeShared<FJsonValueNumber>(Node.Right));
+            Fields.Add(MakeShared<FJsonValueNumber>(Node.Value));
+            Fields.Add(MakeShared<FJsonValueNumber>(Node.Confidence));
+            Fields.Add(MakeShared<FJsonValueNumber>(Node.MeanFine));
+            Nodes.Add(MakeShared<FJsonValueArray>(Fields));
+        }
+        TreesObject->SetArrayField(GetOutputName(static_cast<EOutput>(OutputIndex)), Nodes);
+    }
+    Root->SetObjectField(TEXT("trees"), TreesObject);
+
+    FString Contents;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Contents);
+    if (!FJsonSerializer::Serialize(Root, Writer))
+    {
+        return false;
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+    return FFileHelper::SaveStringToFile(Contents, *FilePath);
+}
+
+bool FGameDirectorPolicy::Load(const FString& FilePath)
+{
+    FString Contents;
+    if (!FFileHelper::LoadFileToString(Contents, *FilePath))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+    FString Schema;
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() || !Root->TryGetStringField(TEXT("schema"), Schema) || Schema != kPolicySchema)
+    {
+        UE_LOG(LogGameDirectorPolicy, Warning, TEXT("%s is not a %s policy."), *FilePath, kPolicySchema);
+        return false;
+    }
+
+    // Feature indices are baked into the trees, so a policy trained on another field layout cannot be used.
+    const TArray<TSharedPtr<FJsonValue>>* FeatureNames = nullptr;
+    if (!Root->TryGetArrayField(TEXT("features"), FeatureNames) || FeatureNames->Num() != NumFeatures)
+    {
+        UE_LOG(LogGameDirectorPolicy, Warning, TEXT("%s was trained on a different scenario layout; retrain it."), *FilePath);
+        return false;
+    }
+
+    for (int32 Feature = 0; Feature < NumFeatures; ++Feature)
+    {
+        if ((*FeatureNames)[Feature]->AsString() != ANSI_TO_TCHAR(FGameDirectorScenario::GetCompactKey(static_cast<FGameDirectorScenario::ECompactField>(Feature))))
+        {
+            UE_LOG(LogGameDirectorPolicy, Warning, TEXT("%s was trained on a different scenario layout; retrain it."), *FilePath);
+            return false;
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* TreesObject = nullptr;
+    if (!Root->TryGetObjectField(TEXT("trees"), TreesObject))
+    {
+        return false;
+    }
+
+    TStaticArray<TArray<FNode>, NumOutputs> LoadedTrees;
+    for (int32 OutputIndex = 0; OutputIndex < NumOutputs; ++OutputIndex)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Nodes = nullptr;
+        if (!(*TreesObject)->TryGetArrayField(GetOutputName(static_cast<EOutput>(OutputIndex)), Nodes) || Nodes->Num() == 0)
+        {
+            UE_LOG(LogGameDirectorPolicy, Warning, TEXT("%s has no %s tree."), *FilePath, GetOutputName(static_cast<EOutput>(OutputIndex)));
+            return false;
+        }
+
+        TArray<FNode>& Tree = LoadedTrees[OutputIndex];
+        for (const TSharedPtr<FJsonValue>& NodeValue : *Nodes)
+        {
+            const TArray<TSharedPtr<FJsonValue>>& Fields = NodeValue->AsArray();
+            if (Fields.Num() != 7)
+            {
+                return false;
+            }
+
+            FNode& Node = Tree.AddDefaulted_GetRef();
+            Node.Feature = static_cast<int32>(Fields[0]->AsNumber());
+            Node.Threshold = static_cast<float>(Fields[1]->AsNumber());
+            Node.Left = static_cast<int32>(Fields[2]->AsNumber());
+            Node.Right = static_cast<int32>(Fields[3]->AsNumber());
+            Node.Value = static_cast<int32>(Fields[4]->AsNumber());
+            Node.Confidence = static_cast<float>(Fields[5]->AsNumber());
+            Node.MeanFine = static_cast<float>(Fields[6]->AsNumber());
+        }
+
+        // BuildNode appends children after their parent; requiring that here keeps FindLeaf from looping on a cycle.
+        for (int32 NodeIndex = 0; NodeIndex < Tree.Num(); ++NodeIndex)
+        {
+            const FNode& Node = Tree[NodeIndex];
+            const bool bLeaf = Node.Feature == INDEX_NONE;
+            if (!bLeaf && (Node.Feature < 0 || Node.Feature >= NumFeatures || !Tree.IsValidIndex(Node.Left) || !Tree.IsValidIndex(Node.Right)
+                || Node.Left <= NodeIndex || Node.Right <= NodeIndex))
+            {
+                UE_LOG(LogGameDirectorPolicy, Warning, TEXT("%s has a malformed %s tree."), *FilePath, GetOutputName(static_cast<EOutput>(OutputIndex)));
+                return false;
+            }
+        }
+    }
+
+    int32 Samples = 0;
+    Root->TryGetNumberField(TEXT("samples"), Samples);
+
+    Trees = MoveTemp(LoadedTrees);
+    NumTrainingSamples = FMath::Max(1, Samples);
+    return true;
+}
+
+bool FGameDirectorPolicy::ParseDecision(const FString& ResponseJSON, FAIDifficulty& OutDecision)
+{
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseJSON);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* ToolCalls = nullptr;
+    if (!Root->TryGetArrayField(TEXT("tool_calls"), ToolCalls))
+    {
+        return false;
+    }
+
+    for (const TSharedPtr<FJsonValue>& ToolValue : *ToolCalls)
+    {
+        const TSharedPtr<FJsonObject> ToolObject = ToolValue.IsValid() ? ToolValue->AsObject() : nullptr;
+        FString ToolName;
+        const TSharedPtr<FJsonObject>* Args = nullptr;
+        if (!ToolObject.IsValid()
+            || !ToolObject->TryGetStringField(TEXT("name"), ToolName)
+            || !ToolName.Equals(TEXT("AdjustAIDifficulty"), ESearchCase::IgnoreCase)
+            || !ToolObject->TryGetObjectField(TEXT("args"), Args))
+        {
+            continue;
+        }
+
+        // The policy only models global decisions; targeted calls depend on which squads and regions exist.
+        FString Target;
+        if ((*Args)->TryGetStringField(TEXT("target"), Target) && !Target.IsEmpty() && !Target.Equals(TEXT("all"), ESearchCase::IgnoreCase))
+        {
+            continue;
+        }
+
+        FAIDifficulty Decision;
+        if (!(*Args)->TryGetNumberField(TEXT("aim_spread_level"), Decision.AimSpreadLevel)
+            || !(*Args)->TryGetNumberField(TEXT("reaction_level"), Decision.ReactionLevel)
+            || !(*Args)->TryGetNumberField(TEXT("aggression_level"), Decision.AggressionLevel)
+            || !(*Args)->TryGetNumberField(TEXT("peek_level"), Decision.PeekLevel))
+        {
+            return false;
+        }
+
+        (*Args)->TryGetNumberField(TEXT("aim_spread_fine"), Decision.AimSpreadFine);
+        (*Args)->TryGetNumberField(TEXT("duration_s"), Decision.DurationS);
+
+        // Same ranges the subsystem clamps to when it applies a response, so training never sees levels it can't emit.
+        Decision.AimSpreadLevel = FMath::Clamp(Decision.AimSpreadLevel, 0, 10);
+        Decision.ReactionLevel = FMath::Clamp(Decision.ReactionLevel, 0, 10);
+        Decision.AggressionLevel = FMath::Clamp(Decision.AggressionLevel, 0, 10);
+        Decision.PeekLevel = FMath::Clamp(Decision.PeekLevel, 0, 10);
+        Decision.DurationS = FMath::Max(0, Decision.DurationS);
+
+        OutDecision = Decision;
+        return true;
+    }
+
+    return false;
+}
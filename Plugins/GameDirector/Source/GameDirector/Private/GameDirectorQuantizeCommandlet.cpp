@@ -0,0 +1,174 @@
+#include "GameDirectorQuantizeCommandlet.h"
+
+#include "GameDirectorModelManager.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+
+#include <llama.h>
+#include <string>
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameDirectorQuantize, Log, All);
+
+namespace
+{
+    const TCHAR* kDefaultQuantizationTypes = TEXT("Q4_K_M,Q5_K_M,Q8_0");
+
+    bool IsQuantizationSource(const FString& Quantization)
+    {
+        return Quantization.IsEmpty()
+            || Quantization.Equals(TEXT("F16"), ESearchCase::IgnoreCase)
+            || Quantization.Equals(TEXT("BF16"), ESearchCase::IgnoreCase)
+            || Quantization.Equals(TEXT("F32"), ESearchCase::IgnoreCase);
+    }
+}
+
+UGameDirectorQuantizeCommandlet::UGameDirectorQuantizeCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UGameDirectorQuantizeCommandlet::Main(const FString& Params)
+{
+#if !WITH_LLAMA
+    UE_LOG(LogGameDirectorQuantize, Error, TEXT("GameDirector was built without llama.cpp (WITH_LLAMA=0); nothing can be quantized."));
+    return 1;
+#else
+    const FString ModelsDirectory = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("AIModels"));
+
+    FString Source;
+    FParse::Value(*Params, TEXT("Source="), Source);
+
+    FString TypesParam = kDefaultQuantizationTypes;
+    FParse::Value(*Params, TEXT("Types="), TypesParam);
+
+    FString OutDir;
+    FParse::Value(*Params, TEXT("OutDir="), OutDir);
+
+    int32 Threads = 0;
+    FParse::Value(*Params, TEXT("Threads="), Threads);
+
+    const bool bForce = FParse::Param(*Params, TEXT("Force"));
+    const bool bAllowRequantize = FParse::Param(*Params, TEXT("AllowRequantize"));
+
+    //--- Collect source models ------------------------------------------------
+    TArray<FString> SourceFiles;
+
+    if (!Source.IsEmpty())
+    {
+        FString SourcePath = Source;
+        if (!FPaths::FileExists(SourcePath))
+        {
+            SourcePath = FPaths::Combine(ModelsDirectory, Source.EndsWith(TEXT(".gguf")) ? Source : Source + TEXT(".gguf"));
+        }
+
+        if (!FPaths::FileExists(SourcePath))
+        {
+            UE_LOG(LogGameDirectorQuantize, Error, TEXT("Source model %s not found."), *Source);
+            return 1;
+        }
+
+        SourceFiles.Add(SourcePath);
+    }
+    else
+    {
+        TArray<FString> FoundModels;
+        IFileManager::Get().FindFiles(FoundModels, *(ModelsDirectory / TEXT("*.gguf")), true, false);
+        FoundModels.Sort();
+
+        for (const FString& ModelFile : FoundModels)
+        {
+            FString BaseName;
+            FString Quantization;
+            FGameDirectorModelManager::SplitModelName(FPaths::GetBaseFilename(ModelFile), BaseName, Quantization);
+
+            if (IsQuantizationSource(Quantization))
+            {
+                SourceFiles.Add(FPaths::Combine(ModelsDirectory, ModelFile));
+            }
+        }
+    }
+
+    if (SourceFiles.Num() == 0)
+    {
+        UE_LOG(LogGameDirectorQuantize, Error, TEXT("No source models to quantize under %s."), *ModelsDirectory);
+        return 1;
+    }
+
+    //--- Parse requested types ------------------------------------------------
+    TArray<FString> Types;
+    TypesParam.ParseIntoArray(Types, TEXT(","), true);
+
+    for (FString& Type : Types)
+    {
+        Type.TrimStartAndEndInline();
+        Type.ToUpperInline();
+
+        if (FGameDirectorModelManager::GetQuantizationFileType(Type) == INDEX_NONE)
+        {
+            UE_LOG(LogGameDirectorQuantize, Error, TEXT("Unknown quantization type %s."), *Type);
+            return 1;
+        }
+    }
+
+    //--- Quantize -------------------------------------------------------------
+    llama_backend_init();
+
+    int32 FailureCount = 0;
+
+    for (const FString& SourceFile : SourceFiles)
+    {
+        FString BaseName;
+        FString SourceQuantization;
+        FGameDirectorModelManager::SplitModelName(FPaths::GetBaseFilename(SourceFile), BaseName, SourceQuantization);
+
+        const FString TargetDirectory = OutDir.IsEmpty() ? FPaths::GetPath(SourceFile) : OutDir;
+        IFileManager::Get().MakeDirectory(*TargetDirectory, true);
+
+        for (const FString& Type : Types)
+        {
+            if (SourceQuantization.Equals(Type, ESearchCase::IgnoreCase))
+            {
+                continue;
+            }
+
+            const FString TargetFile = FPaths::Combine(TargetDirectory, FString::Printf(TEXT("%s.%s.gguf"), *BaseName, *Type));
+            if (!bForce && FPaths::FileExists(TargetFile))
+            {
+                UE_LOG(LogGameDirectorQuantize, Display, TEXT("Skipping %s (exists, use -Force to overwrite)."), *TargetFile);
+                continue;
+            }
+
+            llama_model_quantize_params QuantizeParams = llama_model_quantize_default_params();
+            QuantizeParams.nthread = Threads;
+            QuantizeParams.ftype = static_cast<llama_ftype>(FGameDirectorModelManager::GetQuantizationFileType(Type));
+            QuantizeParams.allow_requantize = bAllowRequantize;
+
+            const std::string SourceUtf8 = TCHAR_TO_UTF8(*SourceFile);
+            const std::string TargetUtf8 = TCHAR_TO_UTF8(*TargetFile);
+
+            UE_LOG(LogGameDirectorQuantize, Display, TEXT("Quantizing %s -> %s"), *SourceFile, *TargetFile);
+
+            const double StartTime = FPlatformTime::Seconds();
+            if (llama_model_quantize(SourceUtf8.c_str(), TargetUtf8.c_str(), &QuantizeParams) != 0)
+            {
+                UE_LOG(LogGameDirectorQuantize, Error, TEXT("llama_model_quantize failed for %s (%s)."), *SourceFile, *Type);
+                ++FailureCount;
+                continue;
+            }
+
+            UE_LOG(LogGameDirectorQuantize, Display, TEXT("Wrote %s (%.1f MB) in %.1fs."),
+                *TargetFile,
+                IFileManager::Get().FileSize(*TargetFile) / (1024.0 * 1024.0),
+                FPlatformTime::Seconds() - StartTime);
+        }
+    }
+
+    llama_backend_free();
+
+    return FailureCount > 0 ? 1 : 0;
+#endif // WITH_LLAMA
+}
@@ -0,0 +1,180 @@
+#include "GameDirectorRecorder.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/Archive.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameDirectorRecorder, Log, All);
+
+FGameDirectorRecorder::FGameDirectorRecorder() = default;
+
+FGameDirectorRecorder::~FGameDirectorRecorder()
+{
+    Close();
+}
+
+bool FGameDirectorRecorder::Open(const FString& InFilePath)
+{
+    FScopeLock Lock(&Mutex);
+
+    Writer.Reset();
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(InFilePath), true);
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*InFilePath, FILEWRITE_Append | FILEWRITE_AllowRead));
+    if (!Writer.IsValid())
+    {
+        UE_LOG(LogGameDirectorRecorder, Error, TEXT("Unable to open recording %s"), *InFilePath);
+        return false;
+    }
+
+    FilePath = InFilePath;
+    SessionStartSeconds = FPlatformTime::Seconds();
+
+    UE_LOG(LogGameDirectorRecorder, Log, TEXT("Recording GameDirector requests to %s"), *FilePath);
+    return true;
+}
+
+void FGameDirectorRecorder::Close()
+{
+    FScopeLock Lock(&Mutex);
+
+    if (Writer.IsValid())
+    {
+        Writer->Close();
+        Writer.Reset();
+    }
+}
+
+bool FGameDirectorRecorder::IsOpen() const
+{
+    FScopeLock Lock(&Mutex);
+    return Writer.IsValid();
+}
+
+double FGameDirectorRecorder::GetSessionTime() const
+{
+    return FPlatformTime::Seconds() - SessionStartSeconds;
+}
+
+void FGameDirectorRecorder::Record(const FGameDirectorRecordEntry& Entry)
+{
+    const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+    Object->SetNumberField(TEXT("t"), Entry.TimeSeconds > 0.0 ? Entry.TimeSeconds : GetSessionTime());
+    Object->SetStringField(TEXT("component"), Entry.ComponentId.ToString());
+    Object->SetStringField(TEXT("adapter"), Entry.AdapterId.ToString());
+    Object->SetNumberField(TEXT("latency_ms"), Entry.LatencyMs);
+
+    TSharedPtr<FJsonObject> Scenario;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Entry.ScenarioJSON);
+    if (FJsonSerializer::Deserialize(Reader, Scenario) && Scenario.IsValid())
+    {
+        Object->SetObjectField(TEXT("scenario"), Scenario);
+    }
+    else
+    {
+        Object->SetStringField(TEXT("scenario"), Entry.ScenarioJSON);
+    }
+
+    Object->SetStringField(TEXT("response"), Entry.ResponseJSON);
+
+    FString Line;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+        TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+    if (!FJsonSerializer::Serialize(Object, JsonWriter))
+    {
+        return;
+    }
+    Line += TEXT("\n");
+
+    const FTCHARToUTF8 Utf8(*Line);
+
+    FScopeLock Lock(&Mutex);
+
+    if (Writer.IsValid())
+    {
+        Writer->Serialize((void*)Utf8.Get(), Utf8.Length());
+        Writer->Flush();
+    }
+}
+
+FString FGameDirectorRecorder::MakeSessionFilePath(const FString& Prefix)
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameDirector"), TEXT("Recordings"),
+        FString::Printf(TEXT("%s-%s.ndjson"), *Prefix, *FDateTime::Now().ToString()));
+}
+
+bool FGameDirectorRecorder::LoadRecording(const FString& InFilePath, TArray<FGameDirectorRecordEntry>& OutEntries)
+{
+    FString Contents;
+    if (!FFileHelper::LoadFileToString(Contents, *InFilePath))
+    {
+        UE_LOG(LogGameDirectorRecorder, Warning, TEXT("Unable to read recording %s"), *InFilePath);
+        return false;
+    }
+
+    TArray<FString> Lines;
+    Contents.ParseIntoArrayLines(Lines, true);
+
+    int32 Skipped = 0;
+    for (const FString& Line : Lines)
+    {
+        FGameDirectorRecordEntry Entry;
+        if (ParseLine(Line, Entry))
+        {
+            OutEntries.Add(MoveTemp(Entry));
+        }
+        else
+        {
+            ++Skipped;
+        }
+    }
+
+    if (Skipped > 0)
+    {
+        UE_LOG(LogGameDirectorRecorder, Warning, TEXT("Skipped %d unreadable lines in %s"), Skipped, *InFilePath);
+    }
+
+    return true;
+}
+
+bool FGameDirectorRecorder::ParseLine(const FString& Line, FGameDirectorRecordEntry& OutEntry)
+{
+    TSharedPtr<FJsonObject> Object;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Line);
+    if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+    {
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* ScenarioObject = nullptr;
+    if (Object->TryGetObjectField(TEXT("scenario"), ScenarioObject))
+    {
+        const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> JsonWriter =
+            TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutEntry.ScenarioJSON);
+        FJsonSerializer::Serialize(ScenarioObject->ToSharedRef(), JsonWriter);
+    }
+    else if (!Object->TryGetStringField(TEXT("scenario"), OutEntry.ScenarioJSON))
+    {
+        return false;
+    }
+
+    FString ComponentId;
+    FString AdapterId;
+    Object->TryGetNumberField(TEXT("t"), OutEntry.TimeSeconds);
+    Object->TryGetStringField(TEXT("component"), ComponentId);
+    Object->TryGetStringField(TEXT("adapter"), AdapterId);
+    Object->TryGetNumberField(TEXT("latency_ms"), OutEntry.LatencyMs);
+    Object->TryGetStringField(TEXT("response"), OutEntry.ResponseJSON);
+
+    OutEntry.ComponentId = ComponentId.IsEmpty() ? NAME_None : FName(*ComponentId);
+    OutEntry.AdapterId = AdapterId.IsEmpty() ? NAME_None : FName(*AdapterId);
+    return true;
+}
@@ -0,0 +1,145 @@
+#include "GameDirectorScenario.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    const ANSICHAR* const kCompactKeys[] = { "hp", "en", "dist", "dtk", "ddl", "hit", "k", "d", "sd", "gt", "ai", "act" };
+    static_assert(UE_ARRAY_COUNT(kCompactKeys) == static_cast<int32>(FGameDirectorScenario::ECompactField::Count), "Missing compact key");
+
+}
+
+bool FGameDirectorScenario::HasCompactField(ECompactField Field) const
+{
+    if (Field < ECompactField::DamageTaken)
+    {
+        return true;
+    }
+    if (Field < ECompactField::GameThreadMs)
+    {
+        return bHasTelemetry;
+    }
+    return Field < ECompactField::Count && bHasServerLoad;
+}
+
+int32 FGameDirectorScenario::GetCompactValue(ECompactField Field) const
+{
+    switch (Field)
+    {
+    case ECompactField::Health:         return FMath::RoundToInt(FMath::Clamp(PlayerHealth, 0.0f, 1.0f) * 100.0f);
+    case ECompactField::EnemyCount:     return EnemyCount;
+    case ECompactField::EnemyDistance:  return FMath::RoundToInt(AvgEnemyDistance / 100.0f);
+    case ECompactField::DamageTaken:    return FMath::RoundToInt(DamageTakenPerSecond);
+    case ECompactField::DamageDealt:    return FMath::RoundToInt(DamageDealtPerSecond);
+    case ECompactField::HitRatio:       return FMath::RoundToInt(FMath::Clamp(HitRatio, 0.0f, 1.0f) * 100.0f);
+    case ECompactField::Kills:          return Kills;
+    case ECompactField::Deaths:         return Deaths;
+    case ECompactField::SinceDeath:     return TimeSinceLastDeath < 0.0f ? -1 : FMath::RoundToInt(TimeSinceLastDeath);
+    case ECompactField::GameThreadMs:   return FMath::RoundToInt(GameThreadMs);
+    case ECompactField::AIMs:           return FMath::RoundToInt(AIMs * 10.0f);
+    case ECompactField::Actors:         return ActorCount;
+    default:                            return 0;
+    }
+}
+
+const ANSICHAR* FGameDirectorScenario::GetCompactKey(ECompactField Field)
+{
+    const int32 Index = static_cast<int32>(Field);
+    return Index < UE_ARRAY_COUNT(kCompactKeys) ? kCompactKeys[Index] : "";
+}
+
+FString FGameDirectorScenario::ToCompactString() const
+{
+    TStringBuilder<128> Builder;
+    for (int32 Index = 0; Index < static_cast<int32>(ECompactField::Count); ++Index)
+    {
+        const ECompactField Field = static_cast<ECompactField>(Index);
+        if (!HasCompactField(Field))
+        {
+            continue;
+        }
+        if (Builder.Len() > 0)
+        {
+            Builder << TEXT(' ');
+        }
+        Builder << GetCompactKey(Field) << TEXT('=') << GetCompactValue(Field);
+    }
+    return FString(Builder.ToView());
+}
+
+FString FGameDirectorScenario::ToJSON() const
+{
+    FString Combat;
+    if (bHasTelemetry)
+    {
+        Combat = FString::Printf(TEXT(",\"dmg_taken_ps\":%.1f,\"dmg_dealt_ps\":%.1f,\"hit_ratio\":%.2f,\"kills\":%d,\"deaths\":%d,\"since_death_s\":%.0f"),
+            DamageTakenPerSecond,
+            DamageDealtPerSecond,
+            HitRatio,
+            Kills,
+            Deaths,
+            TimeSinceLastDeath);
+    }
+
+    FString Server;
+    if (bHasServerLoad)
+    {
+        Server = FString::Printf(TEXT(",\"server\":{\"game_thread_ms\":%.1f,\"ai_ms\":%.2f,\"actors\":%d}"),
+            GameThreadMs,
+            AIMs,
+            ActorCount);
+    }
+
+    return FString::Printf(TEXT("{\"schema\":\"gda.fps.input.v1\",\"player\":{\"hp\":%.3f%s},\"world\":{\"enemy_count\":%d,\"avg_enemy_distance\":%.1f}%s}"),
+        PlayerHealth,
+        *Combat,
+        EnemyCount,
+        AvgEnemyDistance,
+        *Server);
+}
+
+bool FGameDirectorScenario::FromJSON(const FString& JSON, FGameDirectorScenario& OutScenario)
+{
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JSON);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        return false;
+    }
+
+    OutScenario = FGameDirectorScenario();
+
+    const TSharedPtr<FJsonObject>* Player = nullptr;
+    if (Root->TryGetObjectField(TEXT("player"), Player))
+    {
+        (*Player)->TryGetNumberField(TEXT("hp"), OutScenario.PlayerHealth);
+
+        OutScenario.bHasTelemetry = (*Player)->HasField(TEXT("dmg_taken_ps"));
+        (*Player)->TryGetNumberField(TEXT("dmg_taken_ps"), OutScenario.DamageTakenPerSecond);
+        (*Player)->TryGetNumberField(TEXT("dmg_dealt_ps"), OutScenario.DamageDealtPerSecond);
+        (*Player)->TryGetNumberField(TEXT("hit_ratio"), OutScenario.HitRatio);
+        (*Player)->TryGetNumberField(TEXT("kills"), OutScenario.Kills);
+        (*Player)->TryGetNumberField(TEXT("deaths"), OutScenario.Deaths);
+        (*Player)->TryGetNumberField(TEXT("since_death_s"), OutScenario.TimeSinceLastDeath);
+    }
+
+    const TSharedPtr<FJsonObject>* World = nullptr;
+    if (Root->TryGetObjectField(TEXT("world"), World))
+    {
+        (*World)->TryGetNumberField(TEXT("enemy_count"), OutScenario.EnemyCount);
+        (*World)->TryGetNumberField(TEXT("avg_enemy_distance"), OutScenario.AvgEnemyDistance);
+    }
+
+    const TSharedPtr<FJsonObject>* Server = nullptr;
+    if (Root->TryGetObjectField(TEXT("server"), Server))
+    {
+        OutScenario.bHasServerLoad = true;
+        (*Server)->TryGetNumberField(TEXT("game_thread_ms"), OutScenario.GameThreadMs);
+        (*Server)->TryGetNumberField(TEXT("ai_ms"), OutScenario.AIMs);
+        (*Server)->TryGetNumberField(TEXT("actors"), OutScenario.ActorCount);
+    }
+
+    return true;
+}
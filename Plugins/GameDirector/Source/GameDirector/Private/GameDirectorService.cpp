@@ -5,15 +5,28 @@
 #include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
 #include "Engine/World.h"
-#include "EngineUtils.h"
-#include "EnemyCharacter.h"
+#include "GameDirectorEnemyRegistry.h"
+#include "GameDirectorHealthSource.h"
+#include "GameDirectorRecorder.h"
+#include "GameDirectorStats.h"
 #include "GameDirectorSubsystem.h"
+#include "GameDirectorTelemetry.h"
+#include "GameFramework/GameModeBase.h"
 #include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "Kismet/GameplayStatics.h"
-#include "UObject/UnrealType.h"
+#include "Misc/App.h"
+#include "RenderCore.h"
 
 DEFINE_LOG_CATEGORY(LogGameDirectorService);
 
+static TAutoConsoleVariable<bool> CVarGameDirectorRecord(
+    TEXT("GameDirector.Record"),
+    false,
+    TEXT("Record every GameDirector scenario, response and latency to Saved/GameDirector/Recordings."));
+
 void UGameDirectorService::Initialize(FSubsystemCollectionBase& Collection)
 {
     Super::Initialize(Collection);
@@ -58,13 +71,40 @@ void UGameDirectorService::Deinitialize()
 {
     FWorldDelegates::OnPostWorldInitialization.RemoveAll(this);
 
+    // The director outlives the world; do not leave this world's caps behind.
+    UGameDirectorSubsystem* Director = CachedDirector.Get();
+    if (Director && bOverBudget)
+    {
+        FGameDirectorLoadCaps Released = Director->GetLoadCaps();
+        Released.bActive = false;
+        Director->SetLoadCaps(Released);
+    }
+    bOverBudget = false;
+
     CachedDirector.Reset();
     TimeSinceLastEval = 0.0f;
+
+    if (Recorder.IsValid())
+    {
+        Recorder->Close();
+        Recorder.Reset();
+    }
+
     Super::Deinitialize();
 }
 
 void UGameDirectorService::Tick(float DeltaSeconds)
 {
+    if (bTrackServerLoad && CachedDirector.IsValid())
+    {
+        UpdateServerLoad();
+    }
+    else
+    {
+        // Don't let AI time pile up while load tracking is off.
+        FrameAISeconds = 0.0;
+    }
+
     if (!bEnableAutoEvaluation)
     {
         return;
@@ -72,10 +112,84 @@ void UGameDirectorService::Tick(float DeltaSeconds)
 
     TimeSinceLastEval += DeltaSeconds;
 
-    if (TimeSinceLastEval >= EvaluationInterval)
+    if (!bEventDrivenEvaluation)
+    {
+        if (TimeSinceLastEval >= EvaluationInterval)
+        {
+            EvaluateDifficulty();
+        }
+        return;
+    }
+
+    DirtyScore = FMath::Max(0.0f, DirtyScore - DirtyDecayPerSecond * DeltaSeconds);
+
+    const bool bDirty = DirtyScore >= DirtyThreshold && TimeSinceLastEval >= MinEvaluationInterval;
+    const bool bStale = TimeSinceLastEval >= EvaluationInterval;
+
+    if (bDirty || bStale)
     {
+        UE_LOG(LogGameDirectorService, Verbose, TEXT("[GameDirectorService] Evaluating (%s, dirty=%.2f, %.1fs since last)."),
+            bDirty ? TEXT("events") : TEXT("max interval"), DirtyScore, TimeSinceLastEval);
+
         EvaluateDifficulty();
-        TimeSinceLastEval = 0.0f;
+    }
+}
+
+void UGameDirectorService::UpdateServerLoad()
+{
+    // Game thread time is the engine's own measurement of the last frame (the "Game" row of stat unit): it excludes the
+    // max tick rate sleep and the wait for the render thread and GPU, so a client that renders slowly is not mistaken
+    // for an overloaded game thread. AI time is what this world's AI tick points added through
+    // FGameDirectorAITimeScope since the previous frame.
+    const double FrameSeconds = FApp::GetDeltaTime();
+    const float GameThreadMs = static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime));
+    const float AIMs = static_cast<float>(FrameAISeconds * 1000.0);
+    FrameAISeconds = 0.0;
+
+    const float Alpha = LoadSmoothingTime > 0.0f ? 1.0f - FMath::Exp(-static_cast<float>(FrameSeconds) / LoadSmoothingTime) : 1.0f;
+    SmoothedGameThreadMs += (GameThreadMs - SmoothedGameThreadMs) * Alpha;
+    SmoothedAIMs += (AIMs - SmoothedAIMs) * Alpha;
+
+    SET_FLOAT_STAT(STAT_GameDirector_GameThreadMs, SmoothedGameThreadMs);
+    SET_FLOAT_STAT(STAT_GameDirector_AIMs, SmoothedAIMs);
+
+    // Releasing below a fraction of the budget keeps the caps from toggling every frame around the limit.
+    const float Fraction = bOverBudget ? BudgetReleaseFraction : 1.0f;
+    const auto Exceeds = [Fraction](float Value, float Budget) { return Budget > 0.0f && Value > Budget * Fraction; };
+
+    const bool bWasOverBudget = bOverBudget;
+    bOverBudget = Exceeds(SmoothedGameThreadMs, GameThreadBudgetMs) || Exceeds(SmoothedAIMs, AIBudgetMs);
+
+    if (bOverBudget == bWasOverBudget)
+    {
+        return;
+    }
+
+    UE_LOG(LogGameDirectorService, Log, TEXT("[GameDirectorService] %s budget (game thread %.1f ms, AI %.2f ms)."),
+        bOverBudget ? TEXT("Over") : TEXT("Back within"), SmoothedGameThreadMs, SmoothedAIMs);
+
+    FGameDirectorLoadCaps Caps = OverBudgetCaps;
+    Caps.bActive = bOverBudget;
+    CachedDirector->SetLoadCaps(Caps);
+
+    // Let the director see the new load instead of waiting out the interval.
+    DirtyScore = FMath::Max(DirtyScore, DirtyThreshold);
+}
+
+void UGameDirectorService::ReportEvent(EGameDirectorEvent Event, float Magnitude)
+{
+    if (const float* Weight = EventWeights.Find(Event))
+    {
+        DirtyScore += *Weight * FMath::Max(0.0f, Magnitude);
+    }
+}
+
+void UGameDirectorService::ReportEvent(const UObject* WorldContextObject, EGameDirectorEvent Event, float Magnitude)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    if (UGameDirectorService* Service = World ? World->GetSubsystem<UGameDirectorService>() : nullptr)
+    {
+        Service->ReportEvent(Event, Magnitude);
     }
 }
 
@@ -101,6 +215,7 @@ void UGameDirectorService::EvaluateDifficulty()
 
     //--- Timer reset ----------------------------------------------------------
     TimeSinceLastEval = 0.0f;
+    DirtyScore = 0.0f;
 
     //--- Ensure subsystem pointer is valid ------------------------------------
     if (!CachedDirector.IsValid())
@@ -121,30 +236,45 @@ void UGameDirectorService::EvaluateDifficulty()
         Director = CachedDirector.Get();
     }
 
-    //--- Build input JSON -----------------------------------------------------
-    const FString Scenario = BuildScenarioJSON();
-    UE_LOG(LogGameDirectorService, Log, TEXT("[GameDirectorService] Scenario: %s"), *Scenario);
+    //--- Build scenario -------------------------------------------------------
+    const FGameDirectorScenario Scenario = BuildScenario();
+    UE_LOG(LogGameDirectorService, Verbose, TEXT("[GameDirectorService] Scenario: %s"), *Scenario.ToCompactString());
 
     //--- Perform difficulty evaluation ----------------------------------------
     if (Director)
     {
         const TWeakObjectPtr<UGameDirectorService> WeakThis(this);
+        const FName AdapterId = ResolveAdapterForWorld(World);
+        const TSharedPtr<FGameDirectorRecorder> SessionRecorder = GetRecorder();
+        const double RequestTime = FPlatformTime::Seconds();
+
+        // Stamped at request time so paced replays reproduce the request spacing, not the completion spacing.
+        const double SessionTime = SessionRecorder.IsValid() ? SessionRecorder->GetSessionTime() : 0.0;
 
-        Director->RequestInference(TEXT("Difficulty"), Scenario,
-            [WeakThis](const FString& ResultJSON)
+        Director->RequestDifficultyDecision(Scenario,
+            [WeakThis, SessionRecorder, Scenario, AdapterId, RequestTime, SessionTime](const FString& ResultJSON, bool bFromLLM)
             {
-                if (!WeakThis.IsValid())
+                // Only LLM responses are recorded: they are the labels the policy is trained on.
+                if (SessionRecorder.IsValid() && bFromLLM)
                 {
-                    return;
+                    FGameDirectorRecordEntry Entry;
+                    Entry.TimeSeconds = SessionTime;
+                    Entry.ComponentId = TEXT("Difficulty");
+                    Entry.AdapterId = AdapterId;
+                    Entry.ScenarioJSON = Scenario.ToJSON();
+                    Entry.ResponseJSON = ResultJSON;
+                    Entry.LatencyMs = (FPlatformTime::Seconds() - RequestTime) * 1000.0;
+                    SessionRecorder->Record(Entry);
                 }
 
                 if (UGameDirectorService* StrongService = WeakThis.Get())
                 {
                     StrongService->OnDirectorEvaluated.Broadcast(ResultJSON);
                     UE_LOG(LogGameDirectorService, Log,
-                        TEXT("[GameDirectorService] Inference completed: %s"), *ResultJSON);
+                        TEXT("[GameDirectorService] %s completed: %s"), bFromLLM ? TEXT("Inference") : TEXT("Local decision"), *ResultJSON);
                 }
-            });
+            },
+            AdapterId);
 
         UE_LOG(LogGameDirectorService, Log, TEXT("[GameDirectorService] Sent difficulty request to %s"),
             *Director->GetName());
@@ -163,62 +293,60 @@ void UGameDirectorService::EvaluateDifficulty()
     }
 }
 
-FString UGameDirectorService::BuildScenarioJSON() const
+FGameDirectorScenario UGameDirectorService::BuildScenario() const
 {
+    FGameDirectorScenario Scenario;
+
     const UWorld* World = GetWorld();
     if (!World)
     {
-        return TEXT("{}");
+        return Scenario;
     }
 
     const APawn* PlayerPawn = UGameplayStatics::GetPlayerPawn(World, 0);
-    float PlayerHealth = 1.0f;
 
-    if (PlayerPawn)
+    if (const IGameDirectorHealthSource* HealthSource = Cast<IGameDirectorHealthSource>(PlayerPawn))
     {
-        if (const FFloatProperty* HealthProperty = FindFProperty<FFloatProperty>(PlayerPawn->GetClass(), TEXT("Health")))
-        {
-            const void* PropertyPtr = HealthProperty->ContainerPtrToValuePtr<void>(PlayerPawn);
-            PlayerHealth = HealthProperty->GetFloatingPointPropertyValue(PropertyPtr);
-        }
+        Scenario.PlayerHealth = HealthSource->GetHealthFraction();
     }
 
-    int32 EnemyCount = 0;
-    double DistanceAccumulator = 0.0;
-
-    if (PlayerPawn)
+    if (UGameDirectorTelemetry* Telemetry = UGameDirectorTelemetry::Find(UGameplayStatics::GetPlayerController(World, 0)))
     {
-        const FVector PlayerLocation = PlayerPawn->GetActorLocation();
-
-        for (TActorIterator<AEnemyCharacter> It(World); It; ++It)
-        {
-            const AEnemyCharacter* Enemy = *It;
-            if (!IsValid(Enemy))
-            {
-                continue;
-            }
+        const FGameDirectorTelemetrySnapshot Snapshot = Telemetry->GetSnapshot();
+        Scenario.bHasTelemetry = true;
+        Scenario.DamageTakenPerSecond = Snapshot.DamageTakenPerSecond;
+        Scenario.DamageDealtPerSecond = Snapshot.DamageDealtPerSecond;
+        Scenario.HitRatio = Snapshot.HitRatio;
+        Scenario.Kills = Snapshot.Kills;
+        Scenario.Deaths = Snapshot.Deaths;
+        Scenario.TimeSinceLastDeath = Snapshot.TimeSinceLastDeath;
+    }
 
-            ++EnemyCount;
-            DistanceAccumulator += FVector::Dist(PlayerLocation, Enemy->GetActorLocation());
-        }
+    if (bTrackServerLoad)
+    {
+        Scenario.bHasServerLoad = true;
+        Scenario.GameThreadMs = SmoothedGameThreadMs;
+        Scenario.AIMs = SmoothedAIMs;
+        Scenario.ActorCount = World->GetActorCount();
     }
-    else
+
+    if (UGameDirectorEnemyRegistry* Registry = World->GetSubsystem<UGameDirectorEnemyRegistry>())
     {
-        for (TActorIterator<AEnemyCharacter> It(World); It; ++It)
+        Registry->RefreshPositions();
+        Scenario.EnemyCount = Registry->Num();
+
+        if (PlayerPawn)
         {
-            if (IsValid(*It))
-            {
-                ++EnemyCount;
-            }
+            Scenario.AvgEnemyDistance = Registry->ComputeAverageDistance(PlayerPawn->GetActorLocation());
         }
     }
 
-    const double AvgDistance = (EnemyCount > 0) ? DistanceAccumulator / static_cast<double>(EnemyCount) : 0.0;
+    return Scenario;
+}
 
-    return FString::Printf(TEXT("{\"schema\":\"gda.fps.input.v1\",\"player\":{\"hp\":%.3f},\"world\":{\"enemy_count\":%d,\"avg_enemy_distance\":%.1f}}"),
-        PlayerHealth,
-        EnemyCount,
-        AvgDistance);
+FString UGameDirectorService::BuildScenarioJSON() const
+{
+    return GetWorld() ? BuildScenario().ToJSON() : TEXT("{}");
 }
 
 void UGameDirectorService::RefreshCachedDirector()
@@ -251,6 +379,42 @@ void UGameDirectorService::RefreshCachedDirector()
     }
 }
 
+FName UGameDirectorService::ResolveAdapterForWorld(const UWorld* World) const
+{
+    if (const AGameModeBase* GameMode = World ? World->GetAuthGameMode() : nullptr)
+    {
+        if (const FName* AdapterId = GameModeAdapters.Find(GameMode->GetClass()->GetFName()))
+        {
+            return *AdapterId;
+        }
+    }
+
+    return NAME_None;
+}
+
+TSharedPtr<FGameDirectorRecorder> UGameDirectorService::GetRecorder()
+{
+    if (!bRecordScenarios && !CVarGameDirectorRecord.GetValueOnGameThread())
+    {
+        return nullptr;
+    }
+
+    if (!Recorder.IsValid())
+    {
+        const TSharedPtr<FGameDirectorRecorder> NewRecorder = MakeShared<FGameDirectorRecorder>();
+        if (!NewRecorder->Open(FGameDirectorRecorder::MakeSessionFilePath(GetNameSafe(GetWorld()))))
+        {
+            // Do not retry every evaluation when the directory is not writable.
+            bRecordScenarios = false;
+            return nullptr;
+        }
+
+        Recorder = NewRecorder;
+    }
+
+    return Recorder;
+}
+
 UWorld* UGameDirectorService::GetWorldSafe() const
 {
     if (const UWorld* SubsystemWorld = GetWorld())
@@ -0,0 +1,163 @@
+#include "GameDirectorSignificance.h"
+
+#include "Engine/World.h"
+#include "GameDirectorStats.h"
+#include "GameFramework/PlayerController.h"
+
+UGameDirectorSignificanceManager::UGameDirectorSignificanceManager()
+    : HighBudget(1.0f, 0.0f, 5, true, true)
+    , MediumBudget(1.5f, 0.1f, 3, true, true)
+    , LowBudget(2.0f, 0.25f, 2, true, false)
+    , DormantBudget(4.0f, 0.5f, 2, false, false)
+{
+}
+
+void UGameDirectorSignificanceManager::Deinitialize()
+{
+    Actors.Reset();
+    Significance.Reset();
+
+    Super::Deinitialize();
+}
+
+void UGameDirectorSignificanceManager::RegisterActor(AActor* Actor)
+{
+    if (!Actor || !Actor->Implements<UGameDirectorSignificant>() || Actors.Contains(Actor))
+    {
+        return;
+    }
+
+    TArray<FViewPoint> Views;
+    GatherViewPoints(Views);
+
+    Actors.Add(Actor);
+    Significance.Add(Classify(Actor, Views, !IsRunningDedicatedServer()));
+    Notify(Actors.Num() - 1);
+}
+
+void UGameDirectorSignificanceManager::UnregisterActor(AActor* Actor)
+{
+    const int32 Index = Actors.Find(Actor);
+    if (Index != INDEX_NONE)
+    {
+        Actors.RemoveAtSwap(Index, EAllowShrinking::No);
+        Significance.RemoveAtSwap(Index, EAllowShrinking::No);
+    }
+}
+
+const FGameDirectorSignificanceBudget& UGameDirectorSignificanceManager::GetBudget(EGameDirectorSignificance InSignificance) const
+{
+    switch (InSignificance)
+    {
+    case EGameDirectorSignificance::High:       return HighBudget;
+    case EGameDirectorSignificance::Medium:     return MediumBudget;
+    case EGameDirectorSignificance::Low:        return LowBudget;
+    default:                                    return DormantBudget;
+    }
+}
+
+void UGameDirectorSignificanceManager::Tick(float DeltaTime)
+{
+    TimeUntilUpdate -= DeltaTime;
+    if (TimeUntilUpdate > 0.0f)
+    {
+        return;
+    }
+    TimeUntilUpdate = UpdateInterval;
+
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_Significance);
+    FGameDirectorAITimeScope AITimeScope(this);
+
+    TArray<FViewPoint> Views;
+    GatherViewPoints(Views);
+
+    // Without a renderer WasRecentlyRendered is always false, so dedicated servers rely on the view cone alone.
+    const bool bCheckRendered = !IsRunningDedicatedServer();
+
+    for (int32 Index = Actors.Num() - 1; Index >= 0; --Index)
+    {
+        const AActor* Actor = Actors[Index];
+        if (!IsValid(Actor))
+        {
+            Actors.RemoveAtSwap(Index, EAllowShrinking::No);
+            Significance.RemoveAtSwap(Index, EAllowShrinking::No);
+            continue;
+        }
+
+        const EGameDirectorSignificance NewSignificance = Classify(Actor, Views, bCheckRendered);
+        if (NewSignificance != Significance[Index])
+        {
+            Significance[Index] = NewSignificance;
+            Notify(Index);
+        }
+    }
+}
+
+void UGameDirectorSignificanceManager::GatherViewPoints(TArray<FViewPoint>& OutViews) const
+{
+    const UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (!PlayerController || !PlayerController->GetPawn())
+        {
+            continue;
+        }
+
+        FVector Location;
+        FRotator Rotation;
+        PlayerController->GetPlayerViewPoint(Location, Rotation);
+        OutViews.Add({ Location, Rotation.Vector() });
+    }
+}
+
+EGameDirectorSignificance UGameDirectorSignificanceManager::Classify(const AActor* Actor, TConstArrayView<FViewPoint> Views, bool bCheckRendered) const
+{
+    // No player to observe anything yet: keep full fidelity rather than guess.
+    if (Views.Num() == 0)
+    {
+        return EGameDirectorSignificance::High;
+    }
+
+    const FVector ActorLocation = Actor->GetActorLocation();
+    const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(ViewConeHalfAngle));
+    const bool bRendered = !bCheckRendered || Actor->WasRecentlyRendered(UpdateInterval + 0.1f);
+
+    int32 Best = static_cast<int32>(EGameDirectorSignificance::Dormant);
+    for (const FViewPoint& View : Views)
+    {
+        const FVector ToActor = ActorLocation - View.Location;
+        const float Distance = ToActor.Size();
+
+        int32 Bucket = Distance < HighDistance ? 0 : Distance < MediumDistance ? 1 : Distance < LowDistance ? 2 : 3;
+
+        const bool bInView = bRendered && FVector::DotProduct(ToActor, View.Direction) >= CosHalfAngle * Distance;
+        if (!bInView)
+        {
+            Bucket = FMath::Min(Bucket + 1, 3);
+        }
+
+        Best = FMath::Min(Best, Bucket);
+    }
+
+    return static_cast<EGameDirectorSignificance>(Best);
+}
+
+void UGameDirectorSignificanceManager::Notify(int32 Index)
+{
+    if (IGameDirectorSignificant* Significant = Cast<IGameDirectorSignificant>(Actors[Index]))
+    {
+        Significant->OnSignificanceChanged(Significance[Index], GetBudget(Significance[Index]));
+    }
+}
+
+UGameDirectorSignificanceManager* UGameDirectorSignificanceManager::Get(const UObject* WorldContextObject)
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    return World ? World->GetSubsystem<UGameDirectorSignificanceManager>() : nullptr;
+}
@@ -0,0 +1,205 @@
+#include "GameDirectorStats.h"
+
+#include "Engine/World.h"
+#include "GameDirectorService.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
+
+DEFINE_STAT(STAT_GameDirector_Inference);
+DEFINE_STAT(STAT_GameDirector_Tokenize);
+DEFINE_STAT(STAT_GameDirector_PromptDecode);
+DEFINE_STAT(STAT_GameDirector_TokenDecode);
+DEFINE_STAT(STAT_GameDirector_Sample);
+DEFINE_STAT(STAT_GameDirector_Parse);
+DEFINE_STAT(STAT_GameDirector_QueueTick);
+DEFINE_STAT(STAT_GameDirector_Policy);
+DEFINE_STAT(STAT_GameDirector_DecisionCache);
+DEFINE_STAT(STAT_GameDirector_Blend);
+DEFINE_STAT(STAT_GameDirector_CombatSchedule);
+DEFINE_STAT(STAT_GameDirector_Significance);
+
+DEFINE_STAT(STAT_GameDirector_PendingJobs);
+DEFINE_STAT(STAT_GameDirector_ActiveJobs);
+DEFINE_STAT(STAT_GameDirector_CompletedJobs);
+DEFINE_STAT(STAT_GameDirector_DeferredCombatEvents);
+
+DEFINE_STAT(STAT_GameDirector_LastQueueWaitMs);
+DEFINE_STAT(STAT_GameDirector_LastTimeToFirstTokenMs);
+DEFINE_STAT(STAT_GameDirector_LastInferenceMs);
+DEFINE_STAT(STAT_GameDirector_PromptTokensPerSecond);
+DEFINE_STAT(STAT_GameDirector_TokensPerSecond);
+DEFINE_STAT(STAT_GameDirector_GameThreadMs);
+DEFINE_STAT(STAT_GameDirector_AIMs);
+
+namespace
+{
+    FAutoConsoleCommandWithOutputDevice GGameDirectorStatsCommand(
+        TEXT("GameDirector.Stats"),
+        TEXT("Prints rolling p50/p95/p99 GameDirector inference latencies and throughput."),
+        FConsoleCommandWithOutputDeviceDelegate::CreateLambda([](FOutputDevice& Ar)
+        {
+            FGameDirectorStats::Get().Dump(Ar);
+        }));
+
+    FAutoConsoleCommand GGameDirectorResetStatsCommand(
+        TEXT("GameDirector.Stats.Reset"),
+        TEXT("Clears the rolling GameDirector latency window."),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            FGameDirectorStats::Get().Reset();
+        }));
+}
+
+FGameDirectorAITimeScope::FGameDirectorAITimeScope(const UObject* WorldContextObject)
+    : Service(nullptr)
+    , StartSeconds(FPlatformTime::Seconds())
+{
+    const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+    Service = World ? World->GetSubsystem<UGameDirectorService>() : nullptr;
+}
+
+FGameDirectorAITimeScope::~FGameDirectorAITimeScope()
+{
+    if (Service)
+    {
+        Service->AddAITime(FPlatformTime::Seconds() - StartSeconds);
+    }
+}
+
+FGameDirectorStats& FGameDirectorStats::Get()
+{
+    static FGameDirectorStats Instance;
+    return Instance;
+}
+
+void FGameDirectorStats::RecordJob(double QueueWaitMs, const FGameDirectorInferenceStats& InferenceStats)
+{
+    {
+        FScopeLock Lock(&Mutex);
+
+        PushLocked(EMetric::QueueWait, QueueWaitMs);
+        PushLocked(EMetric::Tokenize, InferenceStats.TokenizeMs);
+        PushLocked(EMetric::PromptDecode, InferenceStats.PromptDecodeMs);
+        PushLocked(EMetric::PerTokenDecode, InferenceStats.GetPerTokenDecodeMs());
+        PushLocked(EMetric::Sample, InferenceStats.SampleMs);
+        PushLocked(EMetric::TimeToFirstToken, InferenceStats.TimeToFirstTokenMs);
+        PushLocked(EMetric::Inference, InferenceStats.TotalMs);
+        PushLocked(EMetric::TokensPerSecond, InferenceStats.TokensPerSecond);
+    }
+
+    INC_DWORD_STAT(STAT_GameDirector_CompletedJobs);
+    SET_FLOAT_STAT(STAT_GameDirector_LastQueueWaitMs, QueueWaitMs);
+    SET_FLOAT_STAT(STAT_GameDirector_LastTimeToFirstTokenMs, InferenceStats.TimeToFirstTokenMs);
+    SET_FLOAT_STAT(STAT_GameDirector_LastInferenceMs, InferenceStats.TotalMs);
+    SET_FLOAT_STAT(STAT_GameDirector_PromptTokensPerSecond, InferenceStats.PromptTokensPerSecond);
+    SET_FLOAT_STAT(STAT_GameDirector_TokensPerSecond, InferenceStats.TokensPerSecond);
+}
+
+void FGameDirectorStats::RecordSample(EMetric Metric, double Value)
+{
+    if (Metric >= EMetric::Count)
+    {
+        return;
+    }
+
+    FScopeLock Lock(&Mutex);
+    PushLocked(Metric, Value);
+}
+
+void FGameDirectorStats::PushLocked(EMetric Metric, double Value)
+{
+    FWindow& Window = Windows[static_cast<int32>(Metric)];
+    Window.Values[Window.NextIndex] = Value;
+    Window.NextIndex = (Window.NextIndex + 1) % kWindowSize;
+    Window.NumValues = FMath::Min(Window.NumValues + 1, kWindowSize);
+}
+
+bool FGameDirectorStats::GetPercentiles(EMetric Metric, double& OutP50, double& OutP95, double& OutP99, int32& OutNumSamples) const
+{
+    OutP50 = OutP95 = OutP99 = 0.0;
+    OutNumSamples = 0;
+
+    if (Metric >= EMetric::Count)
+    {
+        return false;
+    }
+
+    TArray<double> Sorted;
+    {
+        FScopeLock Lock(&Mutex);
+
+        const FWindow& Window = Windows[static_cast<int32>(Metric)];
+        Sorted.Append(Window.Values.GetData(), Window.NumValues);
+    }
+
+    if (Sorted.Num() == 0)
+    {
+        return false;
+    }
+
+    Sorted.Sort();
+
+    OutP50 = PercentileOfSorted(Sorted, 0.50);
+    OutP95 = PercentileOfSorted(Sorted, 0.95);
+    OutP99 = PercentileOfSorted(Sorted, 0.99);
+    OutNumSamples = Sorted.Num();
+    return true;
+}
+
+void FGameDirectorStats::Dump(FOutputDevice& Ar) const
+{
+    Ar.Logf(TEXT("GameDirector stats (last %d samples per metric):"), kWindowSize);
+    Ar.Logf(TEXT("  %-20s %6s %10s %10s %10s"), TEXT("Metric"), TEXT("N"), TEXT("p50"), TEXT("p95"), TEXT("p99"));
+
+    for (int32 MetricIndex = 0; MetricIndex < static_cast<int32>(EMetric::Count); ++MetricIndex)
+    {
+        const EMetric Metric = static_cast<EMetric>(MetricIndex);
+
+        double P50 = 0.0;
+        double P95 = 0.0;
+        double P99 = 0.0;
+        int32 NumSamples = 0;
+        GetPercentiles(Metric, P50, P95, P99, NumSamples);
+
+        Ar.Logf(TEXT("  %-20s %6d %10.2f %10.2f %10.2f"), GetMetricName(Metric), NumSamples, P50, P95, P99);
+    }
+}
+
+void FGameDirectorStats::Reset()
+{
+    FScopeLock Lock(&Mutex);
+
+    for (FWindow& Window : Windows)
+    {
+        Window.NextIndex = 0;
+        Window.NumValues = 0;
+    }
+}
+
+double FGameDirectorStats::PercentileOfSorted(const TArray<double>& Sorted, double Percentile)
+{
+    if (Sorted.Num() == 0)
+    {
+        return 0.0;
+    }
+
+    const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+    return Sorted[Index];
+}
+
+const TCHAR* FGameDirectorStats::GetMetricName(EMetric Metric)
+{
+    switch (Metric)
+    {
+    case EMetric::QueueWait:        return TEXT("QueueWaitMs");
+    case EMetric::Tokenize:         return TEXT("TokenizeMs");
+    case EMetric::PromptDecode:     return TEXT("PromptDecodeMs");
+    case EMetric::PerTokenDecode:   return TEXT("PerTokenDecodeMs");
+    case EMetric::Sample:           return TEXT("SampleMs");
+    case EMetric::Parse:            return TEXT("ParseMs");
+    case EMetric::TimeToFirstToken: return TEXT("TimeToFirstTokenMs");
+    case EMetric::Inference:        return TEXT("InferenceMs");
+    case EMetric::TokensPerSecond:  return TEXT("TokensPerSecond");
+    default:                        return TEXT("Unknown");
+    }
+}
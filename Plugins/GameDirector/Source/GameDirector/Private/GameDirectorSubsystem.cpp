@@ -2,13 +2,19 @@
 
 #include "GameDirectorJob.h"
 #include "GameDirectorJobQueue.h"
+#include "GameDirectorModelManager.h"
+#include "GameDirectorStats.h"
+#include "GameDirectorTrace.h"
 #include "GameDirectorTypes.h"
 #include "LlamaRunner.h"
+#include "MockLlamaRunner.h"
 
 #include "Containers/Ticker.h"
 #include "Dom/JsonObject.h"
 #include "Engine/World.h"
 #include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
 #include "Misc/Paths.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
@@ -31,34 +37,80 @@ void UGameDirectorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     BaselineDifficulty.DurationS = 0;
     CurrentDifficulty = BaselineDifficulty;
 
-    LlamaRunner = MakeShared<FLlamaRunner>();
+    DifficultyTargets.Reset();
+    DifficultyTargetIndex.Reset();
+    FindOrAddDifficultyTarget(TEXT("all"));
 
-    const FString ModelPath = ResolveModelPath();
-    if (ModelPath.IsEmpty())
+    DecisionCache.Reset(bUseDecisionCache ? DecisionCacheSize : 0);
+
+    // Loaded before any model so the policy tier still works when no GGUF is shipped.
+    if (bUsePolicyTier && !PolicyFile.IsEmpty())
     {
-        UE_LOG(LogGameDirector, Warning, TEXT("No GGUF model found under Content/AIModels/. GameDirector subsystem will be inactive."));
-        LlamaRunner.Reset();
-        OnDifficultyChanged.Broadcast(CurrentDifficulty);
+        const FString PolicyPath = FPaths::Combine(FPaths::ProjectContentDir(), PolicyFile);
+        if (Policy.Load(PolicyPath))
+        {
+            UE_LOG(LogGameDirector, Log, TEXT("Loaded difficulty policy trained on %d decisions from %s"), Policy.GetNumTrainingSamples(), *PolicyPath);
+        }
+    }
+
+    if (bUseMockRunner)
+    {
+        FMockLlamaRunnerSettings MockSettings;
+        MockSettings.Distribution = EMockLatencyDistribution::LogNormal;
+        MockSettings.LatencyMs = MockLatencyMs;
+        MockSettings.LatencySpreadMs = MockLatencySpreadMs;
+
+        UE_LOG(LogGameDirector, Log, TEXT("Using mock llama runner (%.0f ms median latency)."), MockLatencyMs);
+        SetRunnerOverride(MakeShared<FMockLlamaRunner>(MockSettings));
+        PublishDifficulty();
         return;
     }
 
-    if (!LlamaRunner->LoadModel(ModelPath))
+    if (!FLlamaRunner::IsAvailable())
     {
-        UE_LOG(LogGameDirector, Error, TEXT("Failed to load llama model at %s"), *ModelPath);
-        LlamaRunner.Reset();
-        OnDifficultyChanged.Broadcast(CurrentDifficulty);
+        UE_LOG(LogGameDirector, Warning, TEXT("GameDirector was built without llama.cpp; only the policy tier and mock runner are available."));
+        PublishDifficulty();
         return;
     }
 
-    UE_LOG(LogGameDirector, Log, TEXT("Loaded llama model from %s"), *ModelPath);
+    const uint64 MemoryBudgetBytes = static_cast<uint64>(FMath::Max(0, ModelMemoryBudgetMB)) * 1024 * 1024;
+    ModelManager = MakeShared<FGameDirectorModelManager>(MemoryBudgetBytes);
 
-    JobQueue = MakeShared<FGameDirectorJobQueue>(LlamaRunner, MaxConcurrentJobs);
-    if (!JobQueueTickerHandle.IsValid())
+    if (ModelManager->DiscoverModels(GetModelsDirectory()) == 0)
     {
-        JobQueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UGameDirectorSubsystem::PumpJobQueue));
+        UE_LOG(LogGameDirector, Warning, TEXT("No GGUF model found under Content/AIModels/. GameDirector subsystem will be inactive."));
+        ModelManager.Reset();
+        PublishDifficulty();
+        return;
+    }
+
+    // Sized once: the free memory figure drops as soon as a variant loads, which would pick a smaller one next time.
+    ModelBudget = MakeModelBudget();
+    ResolvedModelIds.Reset();
+    DefaultModelId = ResolveDefaultModelId();
+
+    // Adapters/<ModelId>/*.gguf belong to that base model; loose files in Adapters/ belong to the default model.
+    const FString AdaptersDirectory = FPaths::Combine(GetModelsDirectory(), TEXT("Adapters"));
+    ModelManager->DiscoverAdapters(DefaultModelId, AdaptersDirectory);
+    for (const FName ModelId : ModelManager->GetRegisteredModels())
+    {
+        ModelManager->DiscoverAdapters(ModelId, FPaths::Combine(AdaptersDirectory, ModelId.ToString()));
     }
 
-    OnDifficultyChanged.Broadcast(CurrentDifficulty);
+    // Load the default model eagerly; other models are loaded on demand or via PrefetchModel.
+    if (!ModelManager->AcquireRunner(DefaultModelId).IsValid())
+    {
+        UE_LOG(LogGameDirector, Error, TEXT("Failed to load llama model at %s"), *ModelManager->GetModelPath(DefaultModelId));
+        ModelManager.Reset();
+        PublishDifficulty();
+        return;
+    }
+
+    UE_LOG(LogGameDirector, Log, TEXT("Loaded llama model %s from %s"), *DefaultModelId.ToString(), *ModelManager->GetModelPath(DefaultModelId));
+
+    CreateJobQueue();
+
+    PublishDifficulty();
 }
 
 void UGameDirectorSubsystem::Deinitialize()
@@ -66,6 +118,10 @@ void UGameDirectorSubsystem::Deinitialize()
     if (UWorld* World = GetWorld())
     {
         World->GetTimerManager().ClearTimer(RestoreTimerHandle);
+        for (FDifficultyTarget& Target : DifficultyTargets)
+        {
+            World->GetTimerManager().ClearTimer(Target.RestoreTimerHandle);
+        }
     }
 
     if (JobQueueTickerHandle.IsValid())
@@ -75,31 +131,53 @@ void UGameDirectorSubsystem::Deinitialize()
     }
 
     JobQueue.Reset();
-    LlamaRunner.Reset();
+    RunnerOverride.Reset();
+    ModelManager.Reset();
 
     Super::Deinitialize();
 }
 
-void UGameDirectorSubsystem::RequestInference(FName ComponentId, const FString& ScenarioJSON, TFunction<void(const FString&)> OnResult)
+void UGameDirectorSubsystem::RequestInference(FName ComponentId, const FString& ScenarioJSON, TFunction<void(const FString&)> OnResult, FName ModelId, FName AdapterId)
 {
-    if (!LlamaRunner.IsValid())
+    FGameDirectorScenario Scenario;
+    if (!FGameDirectorScenario::FromJSON(ScenarioJSON, Scenario))
+    {
+        UE_LOG(LogGameDirector, Error, TEXT("RequestInference only accepts gda.fps.input.v1 scenarios; rejected: %s"), *ScenarioJSON);
+
+        // Report the failure like a failed inference so callers waiting on the callback don't hang.
+        if (OnResult)
+        {
+            OnResult(FString());
+        }
+        return;
+    }
+
+    RequestInference(ComponentId, Scenario, MoveTemp(OnResult), ModelId, AdapterId);
+}
+
+void UGameDirectorSubsystem::RequestInference(FName ComponentId, const FGameDirectorScenario& Scenario, TFunction<void(const FString&)> OnResult, FName ModelId, FName AdapterId)
+{
+    if (!ModelManager.IsValid() && !RunnerOverride.IsValid())
     {
         UE_LOG(LogGameDirector, Warning, TEXT("RequestInference called but no llama model is loaded."));
         return;
     }
 
-    if (!JobQueue.IsValid())
+    const FName ResolvedModelId = ResolveModelId(ModelId);
+    if (!ModelId.IsNone() && ResolvedModelId.IsNone() && !RunnerOverride.IsValid())
     {
-        JobQueue = MakeShared<FGameDirectorJobQueue>(LlamaRunner, MaxConcurrentJobs);
+        UE_LOG(LogGameDirector, Warning, TEXT("RequestInference called with unknown model %s."), *ModelId.ToString());
+        return;
+    }
 
-        if (!JobQueueTickerHandle.IsValid())
-        {
-            JobQueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
-                FTickerDelegate::CreateUObject(this, &UGameDirectorSubsystem::PumpJobQueue));
-        }
+    if (!JobQueue.IsValid())
+    {
+        CreateJobQueue();
     }
 
-    const TSharedPtr<FGameDirectorJob> Job = MakeShared<FGameDirectorJob>(ComponentId, ScenarioJSON, FGameDirectorJob::EPriority::Normal);
+    const TSharedPtr<FGameDirectorJob> Job = MakeShared<FGameDirectorJob>(ComponentId, Scenario, FGameDirectorJob::EPriority::Normal);
+    Job->ModelId = ResolvedModelId;
+    Job->AdapterId = AdapterId.IsNone() ? ActiveAdapterId : AdapterId;
     Job->OnComplete = MoveTemp(OnResult);
 
     UE_LOG(LogGameDirector, Log, TEXT("[GameDirectorSubsystem] Queuing inference job for %s."), *ComponentId.ToString());
@@ -107,17 +185,89 @@ void UGameDirectorSubsystem::RequestInference(FName ComponentId, const FString&
     JobQueue->EnqueueJob(Job);
 }
 
+void UGameDirectorSubsystem::PrefetchModel(FName ModelId)
+{
+    if (ModelManager.IsValid())
+    {
+        const FName ResolvedModelId = ResolveModelId(ModelId);
+        ModelManager->Prefetch(ResolvedModelId.IsNone() ? DefaultModelId : ResolvedModelId);
+    }
+}
+
+void UGameDirectorSubsystem::SetActiveAdapter(FName AdapterId)
+{
+    if (!AdapterId.IsNone() && ModelManager.IsValid() && !ModelManager->HasAdapter(DefaultModelId, AdapterId))
+    {
+        UE_LOG(LogGameDirector, Warning, TEXT("LoRA adapter %s is not registered for model %s."), *AdapterId.ToString(), *DefaultModelId.ToString());
+    }
+
+    ActiveAdapterId = AdapterId;
+    UE_LOG(LogGameDirector, Log, TEXT("Active LoRA adapter set to %s"), *ActiveAdapterId.ToString());
+}
+
 void UGameDirectorSubsystem::RequestDifficultyUpdate(const FString& Scenario)
 {
-    const TWeakObjectPtr<UGameDirectorSubsystem> WeakThis(this);
+    FGameDirectorScenario ParsedScenario;
+    if (!FGameDirectorScenario::FromJSON(Scenario, ParsedScenario))
+    {
+        UE_LOG(LogGameDirector, Error, TEXT("RequestDifficultyUpdate only accepts gda.fps.input.v1 scenarios; rejected: %s"), *Scenario);
+        return;
+    }
+
+    RequestDifficultyDecision(ParsedScenario);
+}
+
+void UGameDirectorSubsystem::RequestDifficultyDecision(const FGameDirectorScenario& Scenario, TFunction<void(const FString&, bool bFromLLM)> OnResult, FName AdapterId)
+{
+    const double Now = FPlatformTime::Seconds();
 
-    RequestInference(TEXT("Difficulty"), Scenario, [WeakThis](const FString& ResultJSON)
+    const auto ApplyLocalDecision = [this, &OnResult](const FAIDifficulty& Decision, const FString& Reason)
     {
-        if (!WeakThis.IsValid())
+        ApplyDifficulty(GlobalDifficultyTarget, Decision, TEXT("tune_difficulty"), Reason);
+        if (OnResult)
         {
-            return;
+            OnResult(Decision.ToResponseJSON(Reason), false);
+        }
+    };
+
+    //--- Nearest-neighbour tier -----------------------------------------------
+    bool bAppliedLocally = false;
+    if (bUseDecisionCache)
+    {
+        FAIDifficulty Decision;
+        float Similarity = 0.0f;
+        if (DecisionCache.Find(Scenario, DecisionCacheSimilarity, DecisionCacheMaxAgeS, Now, Decision, Similarity))
+        {
+            ApplyLocalDecision(Decision, FString::Printf(TEXT("Cached decision (similarity %.3f)"), Similarity));
+            bAppliedLocally = true;
         }
+    }
+
+    //--- Policy tier ----------------------------------------------------------
+    if (!bAppliedLocally && bUsePolicyTier && Policy.IsValid())
+    {
+        FAIDifficulty Decision;
+        float Confidence = 0.0f;
+        if (Policy.Predict(Scenario, Decision, Confidence) && (Confidence >= PolicyConfidenceThreshold || !HasModel()))
+        {
+            ApplyLocalDecision(Decision, FString::Printf(TEXT("Distilled policy (confidence %.2f)"), Confidence));
+            bAppliedLocally = true;
+        }
+    }
+
+    //--- LLM tier -------------------------------------------------------------
+    const bool bConsultDue = LLMConsultInterval > 0.0f && Now - LastLLMConsultSeconds >= LLMConsultInterval;
+    if (!HasModel() || (bAppliedLocally && !bConsultDue))
+    {
+        return;
+    }
 
+    LastLLMConsultSeconds = Now;
+
+    const TWeakObjectPtr<UGameDirectorSubsystem> WeakThis(this);
+
+    RequestInference(TEXT("Difficulty"), Scenario, [WeakThis, Scenario, OnResult = MoveTemp(OnResult)](const FString& ResultJSON)
+    {
         UGameDirectorSubsystem* StrongSubsystem = WeakThis.Get();
         if (!StrongSubsystem)
         {
@@ -130,8 +280,22 @@ void UGameDirectorSubsystem::RequestDifficultyUpdate(const FString& Scenario)
             return;
         }
 
-        StrongSubsystem->HandleModelResponse(ResultJSON);
-    });
+        const int32 GlobalVersion = StrongSubsystem->GetDifficultyVersion();
+        if (StrongSubsystem->HandleModelResponse(ResultJSON))
+        {
+            // Only the global decision is cached; targeted calls depend on which squads and regions exist. Cache what
+            // was applied (clamped, missing fields filled in) rather than the raw response, so a cache hit replays it.
+            if (StrongSubsystem->GetDifficultyVersion() != GlobalVersion)
+            {
+                StrongSubsystem->DecisionCache.Add(Scenario, StrongSubsystem->CurrentDifficulty, FPlatformTime::Seconds());
+            }
+
+            if (OnResult)
+            {
+                OnResult(ResultJSON, true);
+            }
+        }
+    }, NAME_None, AdapterId);
 }
 
 bool UGameDirectorSubsystem::IsBusy() const
@@ -139,33 +303,88 @@ bool UGameDirectorSubsystem::IsBusy() const
     return JobQueue.IsValid() && JobQueue->IsBusy();
 }
 
-void UGameDirectorSubsystem::HandleModelResponse(const FString& Response)
+bool UGameDirectorSubsystem::HandleModelResponse(const FString& Response)
 {
     TSharedPtr<FJsonObject> RootObject;
-    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
-    if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
-    {
-        UE_LOG(LogGameDirector, Error, TEXT("Failed to parse llama response as JSON: %s"), *Response);
-        return;
-    }
-
-    FAIDifficulty ParsedDifficulty;
+    TArray<TPair<int32, FAIDifficulty>> ParsedDifficulties;
+    FGameDirectorSpawnPacing ParsedPacing;
+    bool bParsedPacing = false;
     FString Reason;
-    if (!TryParseDifficulty(RootObject, ParsedDifficulty, Reason))
     {
-        UE_LOG(LogGameDirector, Warning, TEXT("No valid AdjustAIDifficulty tool call found in response: %s"), *Response);
-        return;
+        SCOPE_CYCLE_COUNTER(STAT_GameDirector_Parse);
+        const double ParseStart = FPlatformTime::Seconds();
+
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response);
+        const bool bDeserialized = FJsonSerializer::Deserialize(Reader, RootObject) && RootObject.IsValid();
+        const bool bParsedDifficulty = bDeserialized && TryParseDifficulty(RootObject, ParsedDifficulties, Reason);
+        bParsedPacing = bDeserialized && TryParseSpawnPacing(RootObject, ParsedPacing);
+
+        FGameDirectorStats::Get().RecordSample(FGameDirectorStats::EMetric::Parse, (FPlatformTime::Seconds() - ParseStart) * 1000.0);
+
+        if (!bDeserialized)
+        {
+            UE_LOG(LogGameDirector, Error, TEXT("Failed to parse llama response as JSON: %s"), *Response);
+            return false;
+        }
+
+        if (!bParsedDifficulty && !bParsedPacing)
+        {
+            UE_LOG(LogGameDirector, Warning, TEXT("No valid AdjustAIDifficulty or SetSpawnPacing tool call found in response: %s"), *Response);
+            return false;
+        }
     }
 
     FString Intent;
     RootObject->TryGetStringField(TEXT("intent"), Intent);
 
-    CurrentDifficulty = ParsedDifficulty;
+    for (const TPair<int32, FAIDifficulty>& Parsed : ParsedDifficulties)
+    {
+        ApplyDifficulty(Parsed.Key, Parsed.Value, Intent, Reason);
+    }
+
+    if (bParsedPacing)
+    {
+        const int32 Version = SpawnPacing.Version;
+        SpawnPacing = ParsedPacing;
+        SpawnPacing.Version = Version + 1;
+
+        UE_LOG(LogGameDirector, Log, TEXT("Spawn pacing adjusted (%s). Intent=%s Reason: %s"), *SpawnPacing.ToString(), *Intent, *Reason);
+    }
+    return true;
+}
+
+void UGameDirectorSubsystem::ApplyDifficulty(int32 TargetHandle, const FAIDifficulty& Difficulty, const FString& Intent, const FString& Reason)
+{
+    UWorld* World = GetWorld();
+
+    if (TargetHandle != GlobalDifficultyTarget)
+    {
+        FDifficultyTarget& Target = DifficultyTargets[TargetHandle];
+        Target.Requested = Difficulty;
+        Target.Snapshot.Difficulty = CapDifficulty(Difficulty);
+        Target.Snapshot.Version = ++LastDifficultyVersion;
+
+        UE_LOG(LogGameDirector, Log, TEXT("AI difficulty adjusted for %s (%s). Intent=%s Reason: %s"), *Target.Selector.ToString(), *Difficulty.ToString(), *Intent, *Reason);
+
+        if (World)
+        {
+            World->GetTimerManager().ClearTimer(Target.RestoreTimerHandle);
+            if (Difficulty.DurationS > 0)
+            {
+                World->GetTimerManager().SetTimer(Target.RestoreTimerHandle,
+                    FTimerDelegate::CreateUObject(this, &UGameDirectorSubsystem::RestoreTarget, TargetHandle), Difficulty.DurationS, false);
+            }
+        }
+        return;
+    }
+
+    CurrentDifficulty = Difficulty;
 
     UE_LOG(LogGameDirector, Log, TEXT("AI difficulty adjusted (%s). Intent=%s Reason: %s"), *CurrentDifficulty.ToString(), *Intent, *Reason);
-    OnDifficultyChanged.Broadcast(CurrentDifficulty);
+    TRACE_GAMEDIRECTOR_CURRENT_PHASE(DifficultyBroadcast);
+    PublishDifficulty();
 
-    if (UWorld* World = GetWorld())
+    if (World)
     {
         World->GetTimerManager().ClearTimer(RestoreTimerHandle);
         if (CurrentDifficulty.DurationS > 0)
@@ -175,15 +394,13 @@ void UGameDirectorSubsystem::HandleModelResponse(const FString& Response)
     }
 }
 
-bool UGameDirectorSubsystem::TryParseDifficulty(const TSharedPtr<FJsonObject>& RootObject, FAIDifficulty& OutDifficulty, FString& OutReason) const
+bool UGameDirectorSubsystem::TryParseDifficulty(const TSharedPtr<FJsonObject>& RootObject, TArray<TPair<int32, FAIDifficulty>>& OutDifficulties, FString& OutReason)
 {
     if (!RootObject.IsValid())
     {
         return false;
     }
 
-    OutDifficulty = CurrentDifficulty;
-
     RootObject->TryGetStringField(TEXT("reason"), OutReason);
     if (OutReason.IsEmpty())
     {
@@ -223,6 +440,22 @@ bool UGameDirectorSubsystem::TryParseDifficulty(const TSharedPtr<FJsonObject>& R
             continue;
         }
 
+        FString TargetSelector;
+        ArgsObject->TryGetStringField(TEXT("target"), TargetSelector);
+
+        // Only selectors that some AI registered are accepted, so model output can't grow the target table.
+        const int32 TargetHandle = TargetSelector.IsEmpty() ? GlobalDifficultyTarget : FindDifficultyTarget(FName(*TargetSelector));
+        if (TargetHandle == INDEX_NONE)
+        {
+            UE_LOG(LogGameDirector, Warning, TEXT("Ignoring AdjustAIDifficulty call with unknown or unregistered target \"%s\"."), *TargetSelector);
+            continue;
+        }
+
+        // Missing fields keep the target's active values, or the global ones when it has no override.
+        const FDifficultyTarget& Target = DifficultyTargets[TargetHandle];
+        FAIDifficulty& OutDifficulty = OutDifficulties.Emplace_GetRef(TargetHandle,
+            TargetHandle != GlobalDifficultyTarget && Target.Snapshot.Version > 0 ? Target.Requested : CurrentDifficulty).Value;
+
         double NumberValue = 0.0;
 
         if (ArgsObject->TryGetNumberField(TEXT("aim_spread_level"), NumberValue))
@@ -254,38 +487,266 @@ bool UGameDirectorSubsystem::TryParseDifficulty(const TSharedPtr<FJsonObject>& R
         {
             OutDifficulty.DurationS = FMath::Max(0, static_cast<int32>(FMath::RoundToInt(NumberValue)));
         }
+    }
+
+    return OutDifficulties.Num() > 0;
+}
 
-        return true;
+bool UGameDirectorSubsystem::TryParseSpawnPacing(const TSharedPtr<FJsonObject>& RootObject, FGameDirectorSpawnPacing& OutPacing) const
+{
+    const TArray<TSharedPtr<FJsonValue>>* ToolCalls = nullptr;
+    if (!RootObject.IsValid() || !RootObject->TryGetArrayField(TEXT("tool_calls"), ToolCalls) || ToolCalls == nullptr)
+    {
+        return false;
     }
 
-    return false;
+    // The last SetSpawnPacing call wins; missing fields keep the current pacing.
+    bool bFound = false;
+    OutPacing = SpawnPacing;
+
+    for (const TSharedPtr<FJsonValue>& ToolValue : *ToolCalls)
+    {
+        const TSharedPtr<FJsonObject> ToolObject = ToolValue.IsValid() ? ToolValue->AsObject() : nullptr;
+        FString ToolName;
+        const TSharedPtr<FJsonObject>* ArgsPtr = nullptr;
+        if (!ToolObject.IsValid()
+            || !ToolObject->TryGetStringField(TEXT("name"), ToolName)
+            || !ToolName.Equals(TEXT("SetSpawnPacing"), ESearchCase::IgnoreCase)
+            || !ToolObject->TryGetObjectField(TEXT("args"), ArgsPtr) || !ArgsPtr || !ArgsPtr->IsValid())
+        {
+            continue;
+        }
+
+        const FJsonObject& Args = **ArgsPtr;
+        double NumberValue = 0.0;
+
+        if (Args.TryGetNumberField(TEXT("target_enemy_count"), NumberValue))
+        {
+            OutPacing.TargetEnemyCount = FMath::Clamp(static_cast<int32>(FMath::RoundToInt(NumberValue)), 0, 32);
+        }
+
+        if (Args.TryGetNumberField(TEXT("spawn_interval_s"), NumberValue))
+        {
+            OutPacing.SpawnIntervalS = FMath::Clamp(static_cast<float>(NumberValue), 0.5f, 60.0f);
+        }
+
+        // The model reasons in meters like the scenario's dist field.
+        if (Args.TryGetNumberField(TEXT("min_distance_m"), NumberValue))
+        {
+            OutPacing.MinSpawnDistance = FMath::Clamp(static_cast<float>(NumberValue), 5.0f, 200.0f) * 100.0f;
+        }
+
+        if (Args.TryGetNumberField(TEXT("max_distance_m"), NumberValue))
+        {
+            OutPacing.MaxSpawnDistance = FMath::Clamp(static_cast<float>(NumberValue), 5.0f, 200.0f) * 100.0f;
+        }
+
+        OutPacing.MaxSpawnDistance = FMath::Max(OutPacing.MinSpawnDistance, OutPacing.MaxSpawnDistance);
+        bFound = true;
+    }
+
+    return bFound;
+}
+
+int32 UGameDirectorSubsystem::FindOrAddDifficultyTarget(FName Selector)
+{
+    if (const int32* Existing = DifficultyTargetIndex.Find(Selector))
+    {
+        return *Existing;
+    }
+
+    const FString SelectorString = Selector.ToString();
+    const bool bValid = SelectorString.Equals(TEXT("all"), ESearchCase::IgnoreCase)
+        || ((SelectorString.StartsWith(TEXT("archetype:")) || SelectorString.StartsWith(TEXT("squad:")) || SelectorString.StartsWith(TEXT("region:")))
+            && !SelectorString.EndsWith(TEXT(":")));
+    if (!bValid)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 TargetHandle = DifficultyTargets.AddDefaulted();
+    DifficultyTargets[TargetHandle].Selector = Selector;
+    DifficultyTargetIndex.Add(Selector, TargetHandle);
+    return TargetHandle;
+}
+
+int32 UGameDirectorSubsystem::FindDifficultyTarget(FName Selector) const
+{
+    const int32* Existing = DifficultyTargetIndex.Find(Selector);
+    return Existing ? *Existing : INDEX_NONE;
+}
+
+const FAIDifficultySnapshot& UGameDirectorSubsystem::GetTargetSnapshot(int32 TargetHandle) const
+{
+    static const FAIDifficultySnapshot Inactive;
+    return DifficultyTargets.IsValidIndex(TargetHandle) ? DifficultyTargets[TargetHandle].Snapshot : Inactive;
+}
+
+FName UGameDirectorSubsystem::MakeDifficultyTargetSelector(const TCHAR* Kind, FName Name)
+{
+    return Name.IsNone() ? NAME_None : FName(*FString::Printf(TEXT("%s:%s"), Kind, *Name.ToString()));
 }
 
 void UGameDirectorSubsystem::RestoreBaseline()
 {
     CurrentDifficulty = BaselineDifficulty;
     UE_LOG(LogGameDirector, Log, TEXT("Restoring baseline difficulty: %s"), *BaselineDifficulty.ToString());
-    OnDifficultyChanged.Broadcast(CurrentDifficulty);
+    PublishDifficulty();
+}
+
+void UGameDirectorSubsystem::RestoreTarget(int32 TargetHandle)
+{
+    // Dropping the override hands the target's AI back to whichever of their other targets published last.
+    if (DifficultyTargets.IsValidIndex(TargetHandle))
+    {
+        UE_LOG(LogGameDirector, Log, TEXT("Difficulty override for %s expired."), *DifficultyTargets[TargetHandle].Selector.ToString());
+        DifficultyTargets[TargetHandle].Snapshot.Version = 0;
+    }
+}
+
+void UGameDirectorSubsystem::PublishDifficulty()
+{
+    FAIDifficultySnapshot& Snapshot = DifficultyTargets[GlobalDifficultyTarget].Snapshot;
+    Snapshot.Difficulty = CapDifficulty(CurrentDifficulty);
+    Snapshot.Version = ++LastDifficultyVersion;
+
+    OnDifficultyChanged.Broadcast(Snapshot.Difficulty);
+}
+
+FAIDifficulty UGameDirectorSubsystem::CapDifficulty(const FAIDifficulty& Difficulty) const
+{
+    FAIDifficulty Capped = Difficulty;
+    if (LoadCaps.bActive)
+    {
+        Capped.AggressionLevel = FMath::Min(Capped.AggressionLevel, LoadCaps.MaxAggressionLevel);
+    }
+    return Capped;
+}
+
+void UGameDirectorSubsystem::SetLoadCaps(const FGameDirectorLoadCaps& Caps)
+{
+    if (Caps == LoadCaps)
+    {
+        return;
+    }
+
+    LoadCaps = Caps;
+    ++LoadCapsVersion;
+    UE_LOG(LogGameDirector, Log, TEXT("Load caps changed: %s"), *LoadCaps.ToString());
+
+    PublishDifficulty();
+
+    for (int32 TargetHandle = GlobalDifficultyTarget + 1; TargetHandle < DifficultyTargets.Num(); ++TargetHandle)
+    {
+        FDifficultyTarget& Target = DifficultyTargets[TargetHandle];
+        if (Target.Snapshot.Version > 0)
+        {
+            Target.Snapshot.Difficulty = CapDifficulty(Target.Requested);
+            Target.Snapshot.Version = ++LastDifficultyVersion;
+        }
+    }
 }
 
-FString UGameDirectorSubsystem::ResolveModelPath() const
+FString UGameDirectorSubsystem::GetModelsDirectory() const
 {
-    const FString ModelsDirectory = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("AIModels"));
+    return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("AIModels"));
+}
 
-    if (!FPaths::DirectoryExists(ModelsDirectory))
+FName UGameDirectorSubsystem::ResolveDefaultModelId()
+{
+    if (!ModelManager.IsValid())
     {
-        return FString();
+        return NAME_None;
     }
 
-    TArray<FString> FoundModels;
-    IFileManager::Get().FindFiles(FoundModels, *(ModelsDirectory / TEXT("*.gguf")), true, false);
+    if (!DefaultModelName.IsNone())
+    {
+        const FName ModelId = ResolveModelId(DefaultModelName);
+        if (!ModelId.IsNone())
+        {
+            return ModelId;
+        }
 
-    if (FoundModels.Num() == 0)
+        UE_LOG(LogGameDirector, Warning, TEXT("Configured default model %s not found under Content/AIModels/."), *DefaultModelName.ToString());
+    }
+
+    const TArray<FName> ModelIds = ModelManager->GetRegisteredModels();
+    if (ModelIds.Num() == 0)
     {
-        return FString();
+        return NAME_None;
     }
 
-    return FPaths::Combine(ModelsDirectory, FoundModels[0]);
+    // Pick the best fitting variant of the first base model rather than whichever file sorts first.
+    FString BaseName;
+    FString Quantization;
+    FGameDirectorModelManager::SplitModelName(ModelIds[0].ToString(), BaseName, Quantization);
+    return ModelManager->SelectVariant(BaseName, ModelBudget);
+}
+
+FName UGameDirectorSubsystem::ResolveModelId(FName RequestedModelId)
+{
+    if (RequestedModelId.IsNone() || !ModelManager.IsValid())
+    {
+        return NAME_None;
+    }
+
+    // An exact file name pins a variant; otherwise treat the name as a base model and pick a variant.
+    if (ModelManager->IsRegistered(RequestedModelId))
+    {
+        return RequestedModelId;
+    }
+
+    if (const FName* Resolved = ResolvedModelIds.Find(RequestedModelId))
+    {
+        return *Resolved;
+    }
+
+    const FName ModelId = ModelManager->SelectVariant(RequestedModelId.ToString(), ModelBudget);
+    ResolvedModelIds.Add(RequestedModelId, ModelId);
+    return ModelId;
+}
+
+FGameDirectorModelBudget UGameDirectorSubsystem::MakeModelBudget() const
+{
+    FGameDirectorModelBudget Budget;
+
+    // Never pick a variant that cannot be paged in next to the game itself.
+    const uint64 TotalBytes = FPlatformMemory::GetStats().TotalPhysical;
+    const uint64 ReservedBytes = static_cast<uint64>(FMath::Max(0, ReservedPhysicalMemoryMB)) * 1024 * 1024;
+    // At least one byte, since 0 would lift the limit; SelectVariant then falls back to the smallest variant.
+    const uint64 AvailableBytes = FMath::Max<uint64>(TotalBytes - FMath::Min(TotalBytes, ReservedBytes), 1);
+    const uint64 ConfiguredBytes = static_cast<uint64>(FMath::Max(0, MaxModelVariantMB)) * 1024 * 1024;
+    Budget.MaxModelBytes = ConfiguredBytes > 0 ? FMath::Min(ConfiguredBytes, AvailableBytes) : AvailableBytes;
+    Budget.MaxDecodeMsPerToken = MaxDecodeMsPerToken;
+    Budget.MemoryBandwidthGBps = MemoryBandwidthGBps;
+    return Budget;
+}
+
+void UGameDirectorSubsystem::SetRunnerOverride(const TSharedPtr<ILlamaRunner>& InRunner)
+{
+    RunnerOverride = InRunner;
+
+    if (RunnerOverride.IsValid() || ModelManager.IsValid())
+    {
+        CreateJobQueue();
+    }
+    else
+    {
+        JobQueue.Reset();
+    }
+}
+
+void UGameDirectorSubsystem::CreateJobQueue()
+{
+    JobQueue = RunnerOverride.IsValid()
+        ? MakeShared<FGameDirectorJobQueue>(RunnerOverride, MaxConcurrentJobs)
+        : MakeShared<FGameDirectorJobQueue>(ModelManager, DefaultModelId, MaxConcurrentJobs);
+    JobQueue->SetDispatchBudgetMs(MaxDispatchMsPerFrame);
+
+    if (!JobQueueTickerHandle.IsValid())
+    {
+        JobQueueTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UGameDirectorSubsystem::PumpJobQueue));
+    }
 }
 
 bool UGameDirectorSubsystem::PumpJobQueue(float DeltaTime)
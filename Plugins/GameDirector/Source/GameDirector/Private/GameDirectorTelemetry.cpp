@@ -0,0 +1,202 @@
+#include "GameDirectorTelemetry.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+
+//--- FGameDirectorTelemetryWindow ---------------------------------------------
+
+FGameDirectorTelemetryWindow::FBucket& FGameDirectorTelemetryWindow::Advance(double Now)
+{
+    const int64 Bucket = FMath::FloorToInt64(Now / BucketSeconds);
+
+    // The clock went backwards (new world): start over.
+    if (HeadBucket != INDEX_NONE && Bucket < HeadBucket)
+    {
+        Reset();
+    }
+
+    if (HeadBucket == INDEX_NONE)
+    {
+        HeadBucket = Bucket;
+        StartTime = Now;
+    }
+
+    const int64 Steps = FMath::Min<int64>(Bucket - HeadBucket, NumBuckets);
+    for (int64 Step = 1; Step <= Steps; ++Step)
+    {
+        FBucket& Expired = Buckets[(HeadBucket + Step) % NumBuckets];
+
+        Totals.DamageTaken = FMath::Max(0.0f, Totals.DamageTaken - Expired.DamageTaken);
+        Totals.DamageDealt = FMath::Max(0.0f, Totals.DamageDealt - Expired.DamageDealt);
+        Totals.ShotsFired -= Expired.ShotsFired;
+        Totals.ShotsHit -= Expired.ShotsHit;
+        Totals.Kills -= Expired.Kills;
+        Totals.Deaths -= Expired.Deaths;
+
+        Expired = FBucket();
+    }
+
+    HeadBucket = Bucket;
+    return Buckets[HeadBucket % NumBuckets];
+}
+
+void FGameDirectorTelemetryWindow::AddDamageTaken(double Now, float Amount)
+{
+    Advance(Now).DamageTaken += Amount;
+    Totals.DamageTaken += Amount;
+}
+
+void FGameDirectorTelemetryWindow::AddDamageDealt(double Now, float Amount)
+{
+    Advance(Now).DamageDealt += Amount;
+    Totals.DamageDealt += Amount;
+}
+
+void FGameDirectorTelemetryWindow::AddShotFired(double Now)
+{
+    ++Advance(Now).ShotsFired;
+    ++Totals.ShotsFired;
+}
+
+void FGameDirectorTelemetryWindow::AddShotHit(double Now)
+{
+    ++Advance(Now).ShotsHit;
+    ++Totals.ShotsHit;
+}
+
+void FGameDirectorTelemetryWindow::AddKill(double Now)
+{
+    ++Advance(Now).Kills;
+    ++Totals.Kills;
+    PushTimestamp(KillTimes, NumKillTimes, KillHead, Now);
+}
+
+void FGameDirectorTelemetryWindow::AddDeath(double Now)
+{
+    ++Advance(Now).Deaths;
+    ++Totals.Deaths;
+    PushTimestamp(DeathTimes, NumDeathTimes, DeathHead, Now);
+}
+
+FGameDirectorTelemetrySnapshot FGameDirectorTelemetryWindow::GetSnapshot(double Now)
+{
+    Advance(Now);
+
+    // Rates are over the time actually observed until the window has filled once.
+    const double WindowSeconds = NumBuckets * BucketSeconds;
+    const float Elapsed = static_cast<float>(FMath::Clamp(Now - StartTime, BucketSeconds, WindowSeconds));
+
+    FGameDirectorTelemetrySnapshot Snapshot;
+    Snapshot.DamageTakenPerSecond = Totals.DamageTaken / Elapsed;
+    Snapshot.DamageDealtPerSecond = Totals.DamageDealt / Elapsed;
+    Snapshot.ShotsFired = Totals.ShotsFired;
+    Snapshot.ShotsHit = Totals.ShotsHit;
+    Snapshot.HitRatio = Totals.ShotsFired > 0 ? FMath::Min(1.0f, static_cast<float>(Totals.ShotsHit) / Totals.ShotsFired) : 0.0f;
+    Snapshot.Kills = Totals.Kills;
+    Snapshot.Deaths = Totals.Deaths;
+
+    if (NumDeathTimes > 0)
+    {
+        const double LastDeath = DeathTimes[(DeathHead + NumTimestamps - 1) % NumTimestamps];
+        Snapshot.TimeSinceLastDeath = static_cast<float>(Now - LastDeath);
+    }
+
+    return Snapshot;
+}
+
+void FGameDirectorTelemetryWindow::Reset()
+{
+    for (FBucket& Bucket : Buckets)
+    {
+        Bucket = FBucket();
+    }
+
+    Totals = FBucket();
+    HeadBucket = INDEX_NONE;
+    StartTime = 0.0;
+    NumKillTimes = NumDeathTimes = 0;
+    KillHead = DeathHead = 0;
+}
+
+void FGameDirectorTelemetryWindow::PushTimestamp(TStaticArray<double, NumTimestamps>& Times, int32& Count, int32& Head, double Now)
+{
+    Times[Head] = Now;
+    Head = (Head + 1) % NumTimestamps;
+    Count = FMath::Min(Count + 1, NumTimestamps);
+}
+
+int32 FGameDirectorTelemetryWindow::CopyTimestamps(const TStaticArray<double, NumTimestamps>& Times, int32 Count, int32 Head, TArray<double>& OutTimes)
+{
+    OutTimes.Reset(Count);
+    for (int32 Offset = 1; Offset <= Count; ++Offset)
+    {
+        OutTimes.Add(Times[(Head + NumTimestamps - Offset) % NumTimestamps]);
+    }
+    return Count;
+}
+
+//--- UGameDirectorTelemetry ---------------------------------------------------
+
+UGameDirectorTelemetry::UGameDirectorTelemetry()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+double UGameDirectorTelemetry::GetNow() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UGameDirectorTelemetry::RecordDamageTaken(float Amount)
+{
+    Window.AddDamageTaken(GetNow(), FMath::Max(0.0f, Amount));
+}
+
+void UGameDirectorTelemetry::RecordDamageDealt(float Amount)
+{
+    Window.AddDamageDealt(GetNow(), FMath::Max(0.0f, Amount));
+}
+
+void UGameDirectorTelemetry::RecordShotFired()
+{
+    Window.AddShotFired(GetNow());
+}
+
+void UGameDirectorTelemetry::RecordShotHit()
+{
+    Window.AddShotHit(GetNow());
+}
+
+void UGameDirectorTelemetry::RecordKill()
+{
+    Window.AddKill(GetNow());
+}
+
+void UGameDirectorTelemetry::RecordDeath()
+{
+    Window.AddDeath(GetNow());
+}
+
+FGameDirectorTelemetrySnapshot UGameDirectorTelemetry::GetSnapshot()
+{
+    return Window.GetSnapshot(GetNow());
+}
+
+UGameDirectorTelemetry* UGameDirectorTelemetry::Find(const AActor* Actor)
+{
+    if (!Actor)
+    {
+        return nullptr;
+    }
+
+    if (UGameDirectorTelemetry* Telemetry = Actor->FindComponentByClass<UGameDirectorTelemetry>())
+    {
+        return Telemetry;
+    }
+
+    const APawn* Pawn = Cast<APawn>(Actor);
+    const AController* Controller = Pawn ? Pawn->GetController() : nullptr;
+    return Controller ? Controller->FindComponentByClass<UGameDirectorTelemetry>() : nullptr;
+}
@@ -0,0 +1,110 @@
+#include "GameDirectorTrace.h"
+
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+#include <atomic>
+
+namespace
+{
+    std::atomic<uint64> GNextGameDirectorJobId{ 1 };
+
+    thread_local uint64 GCurrentGameDirectorJobId = 0;
+
+#if GAMEDIRECTOR_TRACE_ENABLED
+    FString MakeJobRegionName(uint64 JobId, FName ComponentId)
+    {
+        return FString::Printf(TEXT("GameDirector Job %llu (%s)"), JobId, *ComponentId.ToString());
+    }
+#endif
+}
+
+#if GAMEDIRECTOR_TRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(GameDirectorChannel);
+
+UE_TRACE_EVENT_BEGIN(GameDirector, JobPhase)
+    UE_TRACE_EVENT_FIELD(uint64, Cycle)
+    UE_TRACE_EVENT_FIELD(uint64, JobId)
+    UE_TRACE_EVENT_FIELD(uint32, ThreadId)
+    UE_TRACE_EVENT_FIELD(uint8, Phase)
+    UE_TRACE_EVENT_FIELD(UE::Trace::WideString, ComponentId)
+UE_TRACE_EVENT_END()
+#endif
+
+uint64 FGameDirectorTrace::AllocateJobId()
+{
+    return GNextGameDirectorJobId.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FGameDirectorTrace::OutputPhase(uint64 JobId, EGameDirectorTracePhase Phase, FName ComponentId)
+{
+#if GAMEDIRECTOR_TRACE_ENABLED
+    if (!UE_TRACE_CHANNELEXPR_IS_ENABLED(GameDirectorChannel))
+    {
+        return;
+    }
+
+    const FString ComponentName = ComponentId.IsNone() ? FString() : ComponentId.ToString();
+
+    UE_TRACE_LOG(GameDirector, JobPhase, GameDirectorChannel)
+        << JobPhase.Cycle(FPlatformTime::Cycles64())
+        << JobPhase.JobId(JobId)
+        << JobPhase.ThreadId(FPlatformTLS::GetCurrentThreadId())
+        << JobPhase.Phase(static_cast<uint8>(Phase))
+        << JobPhase.ComponentId(*ComponentName, ComponentName.Len());
+#endif
+}
+
+void FGameDirectorTrace::OutputCurrentJobPhase(EGameDirectorTracePhase Phase)
+{
+    if (GCurrentGameDirectorJobId != 0)
+    {
+        OutputPhase(GCurrentGameDirectorJobId, Phase);
+    }
+}
+
+void FGameDirectorTrace::BeginJobRegion(uint64 JobId, FName ComponentId)
+{
+#if GAMEDIRECTOR_TRACE_ENABLED
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GameDirectorChannel))
+    {
+        TRACE_BEGIN_REGION(*MakeJobRegionName(JobId, ComponentId));
+    }
+#endif
+}
+
+void FGameDirectorTrace::EndJobRegion(uint64 JobId, FName ComponentId)
+{
+#if GAMEDIRECTOR_TRACE_ENABLED
+    if (UE_TRACE_CHANNELEXPR_IS_ENABLED(GameDirectorChannel))
+    {
+        TRACE_END_REGION(*MakeJobRegionName(JobId, ComponentId));
+    }
+#endif
+}
+
+const TCHAR* FGameDirectorTrace::GetPhaseName(EGameDirectorTracePhase Phase)
+{
+    switch (Phase)
+    {
+    case EGameDirectorTracePhase::Enqueue:             return TEXT("Enqueue");
+    case EGameDirectorTracePhase::Start:               return TEXT("Start");
+    case EGameDirectorTracePhase::FirstToken:          return TEXT("FirstToken");
+    case EGameDirectorTracePhase::Complete:            return TEXT("Complete");
+    case EGameDirectorTracePhase::Dispatch:            return TEXT("Dispatch");
+    case EGameDirectorTracePhase::DifficultyBroadcast: return TEXT("DifficultyBroadcast");
+    default:                                           return TEXT("Unknown");
+    }
+}
+
+FGameDirectorTrace::FJobScope::FJobScope(uint64 JobId)
+    : PreviousJobId(GCurrentGameDirectorJobId)
+{
+    GCurrentGameDirectorJobId = JobId;
+}
+
+FGameDirectorTrace::FJobScope::~FJobScope()
+{
+    GCurrentGameDirectorJobId = PreviousJobId;
+}
@@ -0,0 +1,166 @@
+#include "GameDirectorTrainPolicyCommandlet.h"
+
+#include "GameDirectorPolicy.h"
+#include "GameDirectorRecorder.h"
+#include "GameDirectorScenario.h"
+
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGameDirectorTrainPolicy, Log, All);
+
+namespace
+{
+    void LoadSamples(const FString& RecordingsPath, TArray<FGameDirectorPolicySample>& OutSamples)
+    {
+        TArray<FString> Files;
+        if (FPaths::DirectoryExists(RecordingsPath))
+        {
+            IFileManager::Get().FindFilesRecursive(Files, *RecordingsPath, TEXT("*.ndjson"), true, false);
+            Files.Sort();
+        }
+        else if (FPaths::FileExists(RecordingsPath))
+        {
+            Files.Add(RecordingsPath);
+        }
+
+        int32 Skipped = 0;
+        for (const FString& File : Files)
+        {
+            TArray<FGameDirectorRecordEntry> Entries;
+            FGameDirectorRecorder::LoadRecording(File, Entries);
+
+            for (const FGameDirectorRecordEntry& Entry : Entries)
+            {
+                FGameDirectorPolicySample Sample;
+                if (FGameDirectorScenario::FromJSON(Entry.ScenarioJSON, Sample.Scenario)
+                    && FGameDirectorPolicy::ParseDecision(Entry.ResponseJSON, Sample.Decision))
+                {
+                    OutSamples.Add(MoveTemp(Sample));
+                }
+                else
+                {
+                    ++Skipped;
+                }
+            }
+        }
+
+        UE_LOG(LogGameDirectorTrainPolicy, Display, TEXT("Loaded %d labelled decisions from %d recordings (%d skipped)."),
+            OutSamples.Num(), Files.Num(), Skipped);
+    }
+}
+
+UGameDirectorTrainPolicyCommandlet::UGameDirectorTrainPolicyCommandlet()
+{
+    IsClient = false;
+    IsEditor = false;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UGameDirectorTrainPolicyCommandlet::Main(const FString& Params)
+{
+    FString RecordingsPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("GameDirector"), TEXT("Recordings"));
+    FParse::Value(*Params, TEXT("Recordings="), RecordingsPath);
+
+    FString OutputPath = FPaths::Combine(FPaths::ProjectContentDir(), TEXT("AIModels"), TEXT("DifficultyPolicy.json"));
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    FGameDirectorPolicy::FTrainingSettings Settings;
+    FParse::Value(*Params, TEXT("MaxDepth="), Settings.MaxDepth);
+    FParse::Value(*Params, TEXT("MinLeaf="), Settings.MinSamplesPerLeaf);
+    Settings.MaxDepth = FMath::Clamp(Settings.MaxDepth, 1, 16);
+    Settings.MinSamplesPerLeaf = FMath::Max(1, Settings.MinSamplesPerLeaf);
+
+    float Holdout = 0.2f;
+    FParse::Value(*Params, TEXT("Holdout="), Holdout);
+    Holdout = FMath::Clamp(Holdout, 0.0f, 0.9f);
+
+    int32 Seed = 0;
+    FParse::Value(*Params, TEXT("Seed="), Seed);
+
+    float Threshold = 0.8f;
+    FParse::Value(*Params, TEXT("Threshold="), Threshold);
+
+    //--- Samples --------------------------------------------------------------
+    TArray<FGameDirectorPolicySample> Samples;
+    LoadSamples(RecordingsPath, Samples);
+
+    if (Samples.Num() < 2 * Settings.MinSamplesPerLeaf)
+    {
+        UE_LOG(LogGameDirectorTrainPolicy, Error, TEXT("Not enough labelled decisions under %s to train a policy."), *RecordingsPath);
+        return 1;
+    }
+
+    // Shuffle once so the holdout is not just the most recent session.
+    FRandomStream Random(Seed);
+    for (int32 Index = Samples.Num() - 1; Index > 0; --Index)
+    {
+        Samples.Swap(Index, Random.RandRange(0, Index));
+    }
+
+    const int32 NumHoldout = FMath::FloorToInt32(Samples.Num() * Holdout);
+    const TConstArrayView<FGameDirectorPolicySample> TrainSet(Samples.GetData(), Samples.Num() - NumHoldout);
+    const TConstArrayView<FGameDirectorPolicySample> TestSet(Samples.GetData() + TrainSet.Num(), NumHoldout);
+
+    //--- Evaluation -----------------------------------------------------------
+    if (TestSet.Num() > 0)
+    {
+        FGameDirectorPolicy Policy;
+        Policy.Train(TrainSet, Settings);
+
+        constexpr int32 NumOutputs = static_cast<int32>(FGameDirectorPolicy::EOutput::Count);
+        int32 Correct[NumOutputs] = {};
+        int32 Confident = 0;
+        int32 ConfidentCorrect = 0;
+
+        for (const FGameDirectorPolicySample& Sample : TestSet)
+        {
+            FAIDifficulty Predicted;
+            float Confidence = 0.0f;
+            Policy.Predict(Sample.Scenario, Predicted, Confidence);
+
+            bool bAllCorrect = true;
+            for (int32 OutputIndex = 0; OutputIndex < NumOutputs; ++OutputIndex)
+            {
+                const FGameDirectorPolicy::EOutput Output = static_cast<FGameDirectorPolicy::EOutput>(OutputIndex);
+                const bool bCorrect = FGameDirectorPolicy::GetOutputValue(Predicted, Output) == FGameDirectorPolicy::GetOutputValue(Sample.Decision, Output);
+                Correct[OutputIndex] += bCorrect ? 1 : 0;
+                bAllCorrect &= bCorrect;
+            }
+
+            if (Confidence >= Threshold)
+            {
+                ++Confident;
+                ConfidentCorrect += bAllCorrect ? 1 : 0;
+            }
+        }
+
+        UE_LOG(LogGameDirectorTrainPolicy, Display, TEXT("Holdout of %d decisions (trained on %d):"), TestSet.Num(), TrainSet.Num());
+        for (int32 OutputIndex = 0; OutputIndex < NumOutputs; ++OutputIndex)
+        {
+            UE_LOG(LogGameDirectorTrainPolicy, Display, TEXT("  %-18s %5.1f%% exact"),
+                FGameDirectorPolicy::GetOutputName(static_cast<FGameDirectorPolicy::EOutput>(OutputIndex)),
+                100.0 * Correct[OutputIndex] / TestSet.Num());
+        }
+        UE_LOG(LogGameDirectorTrainPolicy, Display, TEXT("  confidence >= %.2f: %.1f%% coverage, %.1f%% of those match the LLM on every output"),
+            Threshold,
+            100.0 * Confident / TestSet.Num(),
+            Confident > 0 ? 100.0 * ConfidentCorrect / Confident : 0.0);
+    }
+
+    //--- Final policy ---------------------------------------------------------
+    // The shipped policy uses every sample; the holdout only measured how well this configuration generalizes.
+    FGameDirectorPolicy Policy;
+    Policy.Train(Samples, Settings);
+
+    if (!Policy.Save(OutputPath))
+    {
+        UE_LOG(LogGameDirectorTrainPolicy, Error, TEXT("Unable to write policy to %s."), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogGameDirectorTrainPolicy, Display, TEXT("Wrote policy trained on %d decisions to %s."), Policy.GetNumTrainingSamples(), *OutputPath);
+    return 0;
+}
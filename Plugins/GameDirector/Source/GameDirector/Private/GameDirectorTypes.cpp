@@ -12,3 +12,40 @@ FString FAIDifficulty::ToString() const
         DurationS);
 }
 
+FString FAIDifficulty::ToResponseJSON(const FString& Reason) const
+{
+    return FString::Printf(TEXT("{\"schema\":\"gda.fps.output.v1\",\"intent\":\"tune_difficulty\",\"reason\":\"%s\","
+        "\"tool_calls\":[{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":%d,\"aim_spread_fine\":%.2f,"
+        "\"reaction_level\":%d,\"aggression_level\":%d,\"peek_level\":%d,\"duration_s\":%d}}]}"),
+        *Reason.ReplaceCharWithEscapedChar(),
+        AimSpreadLevel,
+        AimSpreadFine,
+        ReactionLevel,
+        AggressionLevel,
+        PeekLevel,
+        DurationS);
+}
+
+FString FGameDirectorSpawnPacing::ToString() const
+{
+    return FString::Printf(
+        TEXT("TargetEnemyCount=%d SpawnInterval=%.1fs SpawnDistance=%.0f..%.0fcm"),
+        TargetEnemyCount,
+        SpawnIntervalS,
+        MinSpawnDistance,
+        MaxSpawnDistance);
+}
+
+FString FGameDirectorLoadCaps::ToString() const
+{
+    if (!bActive)
+    {
+        return TEXT("None");
+    }
+
+    return FString::Printf(
+        TEXT("MaxAggression=%d MaxFireRate=%.2f MaxEnemies=%d"),
+        MaxAggressionLevel,
+        MaxFireRate,
+        MaxEnemyCount);
+}
@@ -1,6 +1,9 @@
 ﻿#include "LlamaRunner.h"
 
 #include "Misc/Paths.h"
+#include "HAL/PlatformTime.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "GameDirectorTrace.h"
 
 
 #include <algorithm>
@@ -10,16 +13,35 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogLlamaRunner, Log, All);
 
-FLlamaRunner::FLlamaRunner()
-    : Model(nullptr)
-    , Context(nullptr)
-    , bIsLoaded(false)
-{
-}
+#if WITH_LLAMA
 
-FLlamaRunner::~FLlamaRunner()
+namespace
 {
-    Release();
+    /** Segments with values outside [-1, kMaxCachedSegmentValue) are tokenized every time. */
+    constexpr int32 kMaxCachedSegmentValue = 1000;
+    constexpr int32 kMaxCachedSegments = 4096;
+
+    bool TokenizeText(const llama_vocab* Vocab, const char* Text, bool bAddSpecial, std::vector<llama_token>& OutTokens)
+    {
+        const int32_t Length = (int32_t)std::strlen(Text);
+        int32_t Needed = llama_tokenize(Vocab, Text, Length, nullptr, 0, bAddSpecial, bAddSpecial);
+        if (Needed < 0) Needed = -Needed;
+        if (Needed <= 0)
+        {
+            return false;
+        }
+
+        OutTokens.resize((size_t)Needed);
+        const int32_t Count = llama_tokenize(Vocab, Text, Length, OutTokens.data(), (int32_t)OutTokens.size(), bAddSpecial, bAddSpecial);
+        if (Count <= 0)
+        {
+            OutTokens.clear();
+            return false;
+        }
+
+        OutTokens.resize((size_t)Count);
+        return true;
+    }
 }
 
 bool FLlamaRunner::LoadModel(const FString& ModelPath)
@@ -35,6 +57,8 @@ bool FLlamaRunner::LoadModel(const FString& ModelPath)
     const std::string ModelPathUtf8 = TCHAR_TO_UTF8(*ModelPath);
 
     llama_model_params ModelParams = llama_model_default_params();
+    // Map the weights so several runners (or processes) loading the same file share the page cache.
+    ModelParams.use_mmap = true;
     Model = llama_load_model_from_file(ModelPathUtf8.c_str(), ModelParams);
 
     if (!Model)
@@ -44,6 +68,8 @@ bool FLlamaRunner::LoadModel(const FString& ModelPath)
     }
 
    ContextParams = llama_context_default_params();
+    // Keep llama.cpp's own counters on; RunInference reads them for tokens/s.
+    ContextParams.no_perf = false;
     Context = llama_new_context_with_model(Model, ContextParams);
 
     if (!Context)
@@ -60,8 +86,11 @@ bool FLlamaRunner::LoadModel(const FString& ModelPath)
     return true;
 }
 
-FString FLlamaRunner::RunInference(const FString& Prompt)
+FString FLlamaRunner::RunInference(const FGameDirectorScenario& Scenario, FName AdapterId, FGameDirectorInferenceStats* OutStats)
 {
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_Inference);
+    TRACE_CPUPROFILER_EVENT_SCOPE(GameDirector_RunInference);
+
     if (!bIsLoaded || Context == nullptr || Model == nullptr)
     {
         UE_LOG(LogLlamaRunner, Error, TEXT("RunInference called before model was loaded."));
@@ -75,49 +104,38 @@ FString FLlamaRunner::RunInference(const FString& Prompt)
         return FString();
     }
 
-    // ---- 1) Structured system prompt (tight schema control) ----
-    static const char* kSystem =
-        "SYSTEM: You are GameDirector AI for an FPS. "
-        "Only reply with a single JSON object with exactly these keys: schema, intent, reason, tool_calls. "
-        "Do not write any prose before or after the JSON. No markdown. No labels. "
-        "schema must be \"gda.fps.output.v1\". "
-        "tool_calls must be an array with one object of the form: "
-        "{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":int,\"aim_spread_fine\":float,"
-        "\"reaction_level\":int,\"aggression_level\":int,\"peek_level\":int,\"duration_s\":int}}. "
-        "Levels are 1..5, fine is -0.10..+0.10, duration_s is 1..300.";
-
-    static const char* kFewShot =
-        "EXAMPLE OUTPUT ONLY:\n"
-        "{\"schema\":\"gda.fps.output.v1\",\"intent\":\"tune_difficulty\",\"reason\":\"Easing pressure due to fast player deaths.\","
-        "\"tool_calls\":[{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":2,\"aim_spread_fine\":0.05,"
-        "\"reaction_level\":1,\"aggression_level\":1,\"peek_level\":1,\"duration_s\":60}}]}";
-
-    std::string fullPrompt;
-    fullPrompt.reserve(1024);
-    fullPrompt.append(kSystem).append("\n");
-    fullPrompt.append(kFewShot).append("\n");
-    fullPrompt.append("INPUT: ").append(TCHAR_TO_UTF8(*Prompt)).append("\n");
-    fullPrompt.append("OUTPUT: ");
-
-    // ---- 2) Tokenize ----
-    int32_t tok_needed = llama_tokenize(Vocab, fullPrompt.c_str(), (int32_t)fullPrompt.size(), nullptr, 0, true, true);
-    if (tok_needed < 0) tok_needed = -tok_needed;
-    if (tok_needed <= 0)
+    // Adapters and the KV cache are per-context state, so a request owns the context until its last token.
+    FScopeLock Lock(&DecodeMutex);
+
+    FGameDirectorInferenceStats Stats;
+    const double StartTime = FPlatformTime::Seconds();
+    llama_perf_context_reset(Context);
+
+    if (!ApplyAdapter(AdapterId))
     {
-        UE_LOG(LogLlamaRunner, Error, TEXT("Tokenization failed."));
-        return FString();
+        UE_LOG(LogLlamaRunner, Warning, TEXT("LoRA adapter %s is not loaded; running base model."), *AdapterId.ToString());
     }
 
-    std::vector<llama_token> tokens((size_t)tok_needed);
-    int32_t tok_count = llama_tokenize(Vocab, fullPrompt.c_str(), (int32_t)fullPrompt.size(),
-        tokens.data(), (int32_t)tokens.size(), true, true);
-    if (tok_count <= 0)
+    // ---- 1) Prompt tokens ----
+    std::vector<llama_token> tokens;
+    int32_t tok_count = 0;
     {
-        UE_LOG(LogLlamaRunner, Error, TEXT("Tokenization (write) failed."));
-        return FString();
+        SCOPE_CYCLE_COUNTER(STAT_GameDirector_Tokenize);
+        TRACE_CPUPROFILER_EVENT_SCOPE(GameDirector_Tokenize);
+        const double TokenizeStart = FPlatformTime::Seconds();
+
+        if (!BuildPromptTokens(Vocab, Scenario, tokens))
+        {
+            UE_LOG(LogLlamaRunner, Error, TEXT("Tokenization failed."));
+            return FString();
+        }
+
+        tok_count = (int32_t)tokens.size();
+        Stats.TokenizeMs = (FPlatformTime::Seconds() - TokenizeStart) * 1000.0;
+        Stats.PromptTokens = tok_count;
     }
 
-    // ---- 3) Decode prompt ----
+    // ---- 2) Decode prompt ----
     llama_batch prompt_batch = llama_batch_init(tok_count, 0, 1);
     prompt_batch.n_tokens = tok_count;
     for (int i = 0; i < tok_count; ++i)
@@ -128,24 +146,25 @@ FString FLlamaRunner::RunInference(const FString& Prompt)
         prompt_batch.seq_id[i][0] = 0;
         prompt_batch.logits[i] = (i == tok_count - 1);
     }
-#if defined(LLAMA_API_VERSION) && LLAMA_API_VERSION >= 120
-    llama_kv_cache_clear(Context);
-#else
-    // fallback: recreate context if clearing isn't available
-    llama_free(Context);
-    Context = llama_new_context_with_model(Model, ContextParams);
-#endif
+    // Clear the KV cache instead of recreating the context so attached adapters survive between requests.
+    llama_memory_clear(llama_get_memory(Context), true);
+
     {
-        FScopeLock Lock(&DecodeMutex);
+        SCOPE_CYCLE_COUNTER(STAT_GameDirector_PromptDecode);
+        TRACE_CPUPROFILER_EVENT_SCOPE(GameDirector_PromptDecode);
+        const double PromptDecodeStart = FPlatformTime::Seconds();
+
         if (llama_decode(Context, prompt_batch) < 0)
         {
             UE_LOG(LogLlamaRunner, Error, TEXT("llama_decode(prompt) failed."));
             llama_batch_free(prompt_batch);
             return FString();
         }
+
+        Stats.PromptDecodeMs = (FPlatformTime::Seconds() - PromptDecodeStart) * 1000.0;
     }
 
-    // ---- 4) Sampling config ----
+    // ---- 3) Sampling config ----
     const int n_vocab = llama_vocab_n_tokens(Vocab);
     std::vector<float> work_logits((size_t)n_vocab);
     std::vector<int> idx((size_t)n_vocab);
@@ -204,7 +223,7 @@ FString FLlamaRunner::RunInference(const FString& Prompt)
         return choice;
         };
 
-    // ---- 5) Helper to extract first balanced JSON ----
+    // ---- 4) Helper to extract first balanced JSON ----
     auto ExtractFirstJSONObject = [](const std::string& s) -> std::string {
         size_t start = s.find('{');
         if (start == std::string::npos) return {};
@@ -227,7 +246,7 @@ FString FLlamaRunner::RunInference(const FString& Prompt)
         return {};
         };
 
-    // ---- 6) Generation loop ----
+    // ---- 5) Generation loop ----
     std::vector<llama_token> out_tokens;
     out_tokens.reserve(512);
 
@@ -257,9 +276,23 @@ FString FLlamaRunner::RunInference(const FString& Prompt)
         llama_sample_grammar(Context, &grammar);
 #endif
 
-        int id = (temp <= 0.0f && top_k <= 1)
-            ? greedy_pick(logits)
-            : sample_topk_topp_temp(logits, top_k, top_p, temp);
+        int id = 0;
+        {
+            SCOPE_CYCLE_COUNTER(STAT_GameDirector_Sample);
+            const double SampleStart = FPlatformTime::Seconds();
+
+            id = (temp <= 0.0f && top_k <= 1)
+                ? greedy_pick(logits)
+                : sample_topk_topp_temp(logits, top_k, top_p, temp);
+
+            const double SampleEnd = FPlatformTime::Seconds();
+            Stats.SampleMs += (SampleEnd - SampleStart) * 1000.0;
+            if (i == 0)
+            {
+                Stats.TimeToFirstTokenMs = (SampleEnd - StartTime) * 1000.0;
+                TRACE_GAMEDIRECTOR_CURRENT_PHASE(FirstToken);
+            }
+        }
 
         if (llama_vocab_is_eog(Vocab, (llama_token)id)) break;
 
@@ -284,8 +317,12 @@ FString FLlamaRunner::RunInference(const FString& Prompt)
         step.logits[0] = 1;
 
         {
-            FScopeLock Lock(&DecodeMutex);
-            if (llama_decode(Context, step) < 0) break;
+            SCOPE_CYCLE_COUNTER(STAT_GameDirector_TokenDecode);
+            const double DecodeStart = FPlatformTime::Seconds();
+            const int32 DecodeResult = llama_decode(Context, step);
+            Stats.TokenDecodeMs += (FPlatformTime::Seconds() - DecodeStart) * 1000.0;
+
+            if (DecodeResult < 0) break;
         }
 
 #ifdef LLAMA_GRAMMAR_SUPPORT
@@ -300,19 +337,212 @@ FString FLlamaRunner::RunInference(const FString& Prompt)
     llama_batch_free(step);
     llama_batch_free(prompt_batch);
 
-    // ---- 7) Clean output ----
+    // ---- 6) Clean output ----
     std::string out_str = stream;
     std::string json_only = ExtractFirstJSONObject(out_str);
     if (!json_only.empty())
         out_str.swap(json_only);
 
+    // ---- 7) Timings ----
+    const llama_perf_context_data Perf = llama_perf_context(Context);
+    Stats.GeneratedTokens = (int32)out_tokens.size();
+    Stats.PromptTokensPerSecond = Perf.t_p_eval_ms > 0.0 ? 1000.0 * Perf.n_p_eval / Perf.t_p_eval_ms : 0.0;
+    Stats.TokensPerSecond = Perf.t_eval_ms > 0.0 ? 1000.0 * Perf.n_eval / Perf.t_eval_ms : 0.0;
+    Stats.TotalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    if (OutStats)
+    {
+        *OutStats = Stats;
+    }
+
     FString Output(UTF8_TO_TCHAR(out_str.c_str()));
-    UE_LOG(LogLlamaRunner, Display, TEXT("Inference completed. Output: %s"), *Output);
+    UE_LOG(LogLlamaRunner, Display, TEXT("Inference completed in %.1f ms (prompt %d tok @ %.1f tok/s, %d tok @ %.1f tok/s). Output: %s"),
+        Stats.TotalMs, Stats.PromptTokens, Stats.PromptTokensPerSecond, Stats.GeneratedTokens, Stats.TokensPerSecond, *Output);
     return Output;
 }
 
+bool FLlamaRunner::BuildPromptTokens(const llama_vocab* Vocab, const FGameDirectorScenario& Scenario, std::vector<llama_token>& OutTokens)
+{
+    if (PromptPrefixTokens.empty())
+    {
+        // Structured system prompt (tight schema control) followed by one example and the input legend.
+        static const char* kPrefix =
+            "SYSTEM: You are GameDirector AI for an FPS. "
+            "Only reply with a single JSON object with exactly these keys: schema, intent, reason, tool_calls. "
+            "Do not write any prose before or after the JSON. No markdown. No labels. "
+            "schema must be \"gda.fps.output.v1\". "
+            "tool_calls must be an array of objects of the form: "
+            "{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":int,\"aim_spread_fine\":float,"
+            "\"reaction_level\":int,\"aggression_level\":int,\"peek_level\":int,\"duration_s\":int}}. "
+            "Levels are 1..5, fine is -0.10..+0.10, duration_s is 1..300. "
+            "args may add \"target\": \"all\" (default), \"archetype:grunt\", \"archetype:boss\", \"squad:<name>\" or "
+            "\"region:<name>\"; use at most one tool call per target. "
+            "To change how many enemies are alive, add {\"name\":\"SetSpawnPacing\",\"args\":{\"target_enemy_count\":int,"
+            "\"spawn_interval_s\":float,\"min_distance_m\":int,\"max_distance_m\":int}}; count is 0..32, interval 0.5..60.\n"
+            "EXAMPLE OUTPUT ONLY:\n"
+            "{\"schema\":\"gda.fps.output.v1\",\"intent\":\"tune_difficulty\",\"reason\":\"Easing pressure due to fast player deaths.\","
+            "\"tool_calls\":[{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":2,\"aim_spread_fine\":0.05,"
+            "\"reaction_level\":1,\"aggression_level\":1,\"peek_level\":1,\"duration_s\":60}}]}\n"
+            "INPUT fields: hp=health %, en=enemies, dist=mean enemy distance m, dtk/ddl=damage taken/dealt per s, "
+            "hit=hit %, k/d=kills/deaths in last 30 s, sd=s since death (-1 none), gt=server frame ms, "
+            "ai=AI ms x10, act=live actors. When gt or ai is high, prefer fewer enemies and lower aggression.\n"
+            "INPUT:";
+
+        if (!TokenizeText(Vocab, kPrefix, true, PromptPrefixTokens)
+            || !TokenizeText(Vocab, "\nOUTPUT: ", false, PromptSuffixTokens))
+        {
+            PromptPrefixTokens.clear();
+            return false;
+        }
+
+        // SentencePiece-style vocabularies prepend a space to every separately tokenized fragment.
+        const enum llama_vocab_type VocabType = llama_vocab_type(Vocab);
+        bTokenizerAddsSpacePrefix = VocabType == LLAMA_VOCAB_TYPE_SPM || VocabType == LLAMA_VOCAB_TYPE_UGM;
+    }
+
+    OutTokens.clear();
+    OutTokens.reserve(PromptPrefixTokens.size() + PromptSuffixTokens.size() + 64);
+    OutTokens.insert(OutTokens.end(), PromptPrefixTokens.begin(), PromptPrefixTokens.end());
+
+    for (int32 Index = 0; Index < static_cast<int32>(FGameDirectorScenario::ECompactField::Count); ++Index)
+    {
+        const FGameDirectorScenario::ECompactField Field = static_cast<FGameDirectorScenario::ECompactField>(Index);
+        if (!Scenario.HasCompactField(Field))
+        {
+            continue;
+        }
+
+        const int32 Value = Scenario.GetCompactValue(Field);
+
+        // Quantized values repeat constantly, so most segments are a cache hit; outliers are not retained.
+        const bool bCacheable = Value >= -1 && Value < kMaxCachedSegmentValue;
+        const uint32 Key = (static_cast<uint32>(Index) << 16) | static_cast<uint32>(Value + 1);
+
+        if (const std::vector<llama_token>* Cached = bCacheable ? SegmentTokenCache.Find(Key) : nullptr)
+        {
+            OutTokens.insert(OutTokens.end(), Cached->begin(), Cached->end());
+            continue;
+        }
+
+        const ANSICHAR* FieldKey = FGameDirectorScenario::GetCompactKey(Field);
+        ANSICHAR Segment[32];
+        if (bTokenizerAddsSpacePrefix)
+        {
+            FCStringAnsi::Snprintf(Segment, sizeof(Segment), "%s=%d", FieldKey, Value);
+        }
+        else
+        {
+            FCStringAnsi::Snprintf(Segment, sizeof(Segment), " %s=%d", FieldKey, Value);
+        }
+
+        std::vector<llama_token> SegmentTokens;
+        if (!TokenizeText(Vocab, Segment, false, SegmentTokens))
+        {
+            return false;
+        }
+
+        OutTokens.insert(OutTokens.end(), SegmentTokens.begin(), SegmentTokens.end());
+        if (bCacheable && SegmentTokenCache.Num() < kMaxCachedSegments)
+        {
+            SegmentTokenCache.Add(Key, MoveTemp(SegmentTokens));
+        }
+    }
+
+    OutTokens.insert(OutTokens.end(), PromptSuffixTokens.begin(), PromptSuffixTokens.end());
+    return true;
+}
+
+uint64 FLlamaRunner::GetModelSizeBytes() const
+{
+    return Model ? llama_model_size(Model) : 0;
+}
+
+bool FLlamaRunner::LoadAdapter(FName AdapterId, const FString& AdapterPath, float Scale)
+{
+    if (!bIsLoaded || Model == nullptr)
+    {
+        UE_LOG(LogLlamaRunner, Error, TEXT("LoadAdapter called before model was loaded."));
+        return false;
+    }
+
+    if (!FPaths::FileExists(AdapterPath))
+    {
+        UE_LOG(LogLlamaRunner, Error, TEXT("Unable to locate LoRA adapter at path: %s"), *AdapterPath);
+        return false;
+    }
+
+    UnloadAdapter(AdapterId);
 
+    const std::string AdapterPathUtf8 = TCHAR_TO_UTF8(*AdapterPath);
+    llama_adapter_lora* Adapter = llama_adapter_lora_init(Model, AdapterPathUtf8.c_str());
+    if (!Adapter)
+    {
+        UE_LOG(LogLlamaRunner, Error, TEXT("Failed to load LoRA adapter from %s"), *AdapterPath);
+        return false;
+    }
 
+    FScopeLock Lock(&DecodeMutex);
+
+    FLoadedAdapter& Loaded = Adapters.Add(AdapterId);
+    Loaded.Adapter = Adapter;
+    Loaded.Scale = Scale;
+
+    UE_LOG(LogLlamaRunner, Log, TEXT("Loaded LoRA adapter %s from %s"), *AdapterId.ToString(), *AdapterPath);
+    return true;
+}
+
+void FLlamaRunner::UnloadAdapter(FName AdapterId)
+{
+    FScopeLock Lock(&DecodeMutex);
+
+    FLoadedAdapter Loaded;
+    if (!Adapters.RemoveAndCopyValue(AdapterId, Loaded))
+    {
+        return;
+    }
+
+    if (ActiveAdapterId == AdapterId)
+    {
+        if (Context)
+        {
+            llama_rm_adapter_lora(Context, Loaded.Adapter);
+        }
+        ActiveAdapterId = NAME_None;
+    }
+
+    llama_adapter_lora_free(Loaded.Adapter);
+}
+
+bool FLlamaRunner::HasAdapter(FName AdapterId) const
+{
+    FScopeLock Lock(&DecodeMutex);
+    return Adapters.Contains(AdapterId);
+}
+
+bool FLlamaRunner::ApplyAdapter(FName AdapterId)
+{
+    if (AdapterId == ActiveAdapterId)
+    {
+        return true;
+    }
+
+    llama_clear_adapter_lora(Context);
+    ActiveAdapterId = NAME_None;
+
+    if (AdapterId.IsNone())
+    {
+        return true;
+    }
+
+    const FLoadedAdapter* Loaded = Adapters.Find(AdapterId);
+    if (!Loaded || llama_set_adapter_lora(Context, Loaded->Adapter, Loaded->Scale) != 0)
+    {
+        return false;
+    }
+
+    ActiveAdapterId = AdapterId;
+    return true;
+}
 
 void FLlamaRunner::Release()
 {
@@ -322,6 +552,18 @@ void FLlamaRunner::Release()
         Context = nullptr;
     }
 
+    for (const TPair<FName, FLoadedAdapter>& Pair : Adapters)
+    {
+        llama_adapter_lora_free(Pair.Value.Adapter);
+    }
+
+    Adapters.Reset();
+    ActiveAdapterId = NAME_None;
+
+    PromptPrefixTokens.clear();
+    PromptSuffixTokens.clear();
+    SegmentTokenCache.Reset();
+
     if (Model)
     {
         llama_free_model(Model);
@@ -336,3 +578,73 @@ void FLlamaRunner::Release()
     LoadedModelPath.Reset();
     bIsLoaded = false;
 }
+
+void FLlamaRunner::InitializeBackend()
+{
+    llama_backend_init();
+}
+
+void FLlamaRunner::ShutdownBackend()
+{
+    llama_backend_free();
+}
+
+#else // WITH_LLAMA
+
+// Built without the llama.cpp library: every model load fails, so only mock runners can serve requests.
+
+bool FLlamaRunner::LoadModel(const FString& ModelPath)
+{
+    UE_LOG(LogLlamaRunner, Error, TEXT("Cannot load %s: GameDirector was built without llama.cpp (WITH_LLAMA=0)."), *ModelPath);
+    return false;
+}
+
+FString FLlamaRunner::RunInference(const FGameDirectorScenario& Scenario, FName AdapterId, FGameDirectorInferenceStats* OutStats)
+{
+    return FString();
+}
+
+uint64 FLlamaRunner::GetModelSizeBytes() const
+{
+    return 0;
+}
+
+bool FLlamaRunner::LoadAdapter(FName AdapterId, const FString& AdapterPath, float Scale)
+{
+    return false;
+}
+
+void FLlamaRunner::UnloadAdapter(FName AdapterId)
+{
+}
+
+bool FLlamaRunner::HasAdapter(FName AdapterId) const
+{
+    return false;
+}
+
+void FLlamaRunner::Release()
+{
+}
+
+void FLlamaRunner::InitializeBackend()
+{
+}
+
+void FLlamaRunner::ShutdownBackend()
+{
+}
+
+#endif // WITH_LLAMA
+
+FLlamaRunner::FLlamaRunner()
+    : Model(nullptr)
+    , Context(nullptr)
+    , bIsLoaded(false)
+{
+}
+
+FLlamaRunner::~FLlamaRunner()
+{
+    Release();
+}
@@ -0,0 +1,124 @@
+#include "MockLlamaRunner.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+    const TCHAR* kDefaultMockResponses[] =
+    {
+        TEXT("{\"schema\":\"gda.fps.output.v1\",\"intent\":\"tune_difficulty\",\"reason\":\"mock: ease pressure\",\"tool_calls\":[{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":2,\"aim_spread_fine\":0.05,\"reaction_level\":1,\"aggression_level\":1,\"peek_level\":1,\"duration_s\":60}}]}"),
+        TEXT("{\"schema\":\"gda.fps.output.v1\",\"intent\":\"tune_difficulty\",\"reason\":\"mock: hold steady\",\"tool_calls\":[{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":3,\"aim_spread_fine\":0.0,\"reaction_level\":3,\"aggression_level\":3,\"peek_level\":3,\"duration_s\":30}}]}"),
+        TEXT("{\"schema\":\"gda.fps.output.v1\",\"intent\":\"tune_difficulty\",\"reason\":\"mock: raise pressure\",\"tool_calls\":[{\"name\":\"AdjustAIDifficulty\",\"args\":{\"aim_spread_level\":4,\"aim_spread_fine\":-0.05,\"reaction_level\":4,\"aggression_level\":5,\"peek_level\":4,\"duration_s\":45}}]}"),
+    };
+
+    /** Standard normal draw (Box-Muller). */
+    double DrawStandardNormal(FRandomStream& Random)
+    {
+        const double U1 = FMath::Max(static_cast<double>(Random.GetFraction()), UE_DOUBLE_SMALL_NUMBER);
+        const double U2 = Random.GetFraction();
+        return FMath::Sqrt(-2.0 * FMath::Loge(U1)) * FMath::Cos(UE_DOUBLE_TWO_PI * U2);
+    }
+}
+
+FMockLlamaRunner::FMockLlamaRunner(const FMockLlamaRunnerSettings& InSettings)
+    : Settings(InSettings)
+    , Random(InSettings.Seed)
+{
+    if (Settings.Responses.Num() == 0)
+    {
+        for (const TCHAR* Response : kDefaultMockResponses)
+        {
+            Settings.Responses.Add(Response);
+        }
+    }
+}
+
+FString FMockLlamaRunner::RunInference(const FGameDirectorScenario& Scenario, FName AdapterId, FGameDirectorInferenceStats* OutStats)
+{
+    SCOPE_CYCLE_COUNTER(STAT_GameDirector_Inference);
+
+    double LatencyMs = 0.0;
+    bool bInvalid = false;
+    int32 ResponseIndex = 0;
+    DrawRequest(LatencyMs, bInvalid, ResponseIndex);
+
+    const double StartTime = FPlatformTime::Seconds();
+    if (Settings.bSerializeRequests)
+    {
+        DecodeMutex.Lock();
+    }
+
+    if (LatencyMs > 0.0)
+    {
+        FPlatformProcess::Sleep(static_cast<float>(LatencyMs / 1000.0));
+    }
+
+    if (Settings.bSerializeRequests)
+    {
+        DecodeMutex.Unlock();
+    }
+
+    const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    if (OutStats)
+    {
+        const double GenerationMs = ElapsedMs * (1.0 - Settings.TimeToFirstTokenFraction);
+
+        FGameDirectorInferenceStats Stats;
+        Stats.PromptTokens = Settings.PromptTokens;
+        Stats.GeneratedTokens = Settings.GeneratedTokens;
+        Stats.PromptDecodeMs = ElapsedMs * Settings.TimeToFirstTokenFraction;
+        Stats.TimeToFirstTokenMs = Stats.PromptDecodeMs;
+        Stats.TokenDecodeMs = GenerationMs;
+        Stats.TotalMs = ElapsedMs;
+        Stats.PromptTokensPerSecond = Stats.PromptDecodeMs > 0.0 ? 1000.0 * Stats.PromptTokens / Stats.PromptDecodeMs : 0.0;
+        Stats.TokensPerSecond = GenerationMs > 0.0 ? 1000.0 * Stats.GeneratedTokens / GenerationMs : 0.0;
+        *OutStats = Stats;
+    }
+
+    const FString& Response = Settings.Responses[ResponseIndex];
+    return bInvalid ? Response.Left(Response.Len() / 2) : Response;
+}
+
+int64 FMockLlamaRunner::GetRequestCount() const
+{
+    FScopeLock Lock(&RandomMutex);
+    return RequestCount;
+}
+
+void FMockLlamaRunner::DrawRequest(double& OutLatencyMs, bool& bOutInvalid, int32& OutResponseIndex)
+{
+    FScopeLock Lock(&RandomMutex);
+
+    const double Latency = Settings.LatencyMs;
+    const double Spread = Settings.LatencySpreadMs;
+
+    switch (Settings.Distribution)
+    {
+    case EMockLatencyDistribution::Uniform:
+        OutLatencyMs = Latency + Spread * (2.0 * Random.GetFraction() - 1.0);
+        break;
+
+    case EMockLatencyDistribution::Normal:
+        OutLatencyMs = Latency + Spread * DrawStandardNormal(Random);
+        break;
+
+    case EMockLatencyDistribution::LogNormal:
+        OutLatencyMs = Latency > 0.0
+            ? Latency * FMath::Exp(FMath::Loge(1.0 + Spread / Latency) * DrawStandardNormal(Random))
+            : 0.0;
+        break;
+
+    case EMockLatencyDistribution::Fixed:
+    default:
+        OutLatencyMs = Latency;
+        break;
+    }
+
+    OutLatencyMs = FMath::Max(0.0, OutLatencyMs);
+    bOutInvalid = Settings.InvalidResponseRate > 0.0f && Random.GetFraction() < Settings.InvalidResponseRate;
+    OutResponseIndex = static_cast<int32>(RequestCount % Settings.Responses.Num());
+
+    ++RequestCount;
+}
@@ -0,0 +1,165 @@
+#include "GameDirectorJob.h"
+#include "GameDirectorJobQueue.h"
+#include "MockLlamaRunner.h"
+
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace GameDirectorJobQueueTest
+{
+    constexpr double kTimeoutSeconds = 30.0;
+
+    /** Ticks the queue like the subsystem's ticker does until Done returns true. Returns false on timeout. */
+    bool PumpUntil(FGameDirectorJobQueue& Queue, TFunctionRef<bool()> Done)
+    {
+        const double Deadline = FPlatformTime::Seconds() + kTimeoutSeconds;
+        while (!Done())
+        {
+            if (FPlatformTime::Seconds() > Deadline)
+            {
+                return false;
+            }
+
+            Queue.Tick();
+            FPlatformProcess::Sleep(0.0f);
+        }
+
+        // Anything dispatched after Done would be a stray callback; give it a chance to show up.
+        Queue.Tick();
+        return true;
+    }
+
+    TSharedPtr<FGameDirectorJob> MakeJob(FName ComponentId, FGameDirectorJob::EPriority Priority, TFunction<void(const FString&)> OnComplete)
+    {
+        const TSharedPtr<FGameDirectorJob> Job = MakeShared<FGameDirectorJob>(ComponentId, FGameDirectorScenario(), Priority);
+        Job->OnComplete = MoveTemp(OnComplete);
+        return Job;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameDirectorJobQueueFloodTest, "GameDirector.JobQueue.Flood",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGameDirectorJobQueueFloodTest::RunTest(const FString& Parameters)
+{
+    using namespace GameDirectorJobQueueTest;
+
+    constexpr int32 NumJobs = 2000;
+
+    const TSharedPtr<FMockLlamaRunner> Runner = MakeShared<FMockLlamaRunner>();
+    const TSharedPtr<FGameDirectorJobQueue> Queue = MakeShared<FGameDirectorJobQueue>(Runner, 4);
+
+    int32 NumCompleted = 0;
+    int32 NumEmpty = 0;
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < NumJobs; ++Index)
+    {
+        Queue->EnqueueJob(MakeJob(TEXT("Flood"), FGameDirectorJob::EPriority::Normal, [&NumCompleted, &NumEmpty](const FString& Result)
+        {
+            ++NumCompleted;
+            NumEmpty += Result.IsEmpty() ? 1 : 0;
+        }));
+    }
+
+    const bool bFinished = PumpUntil(*Queue, [&NumCompleted]() { return NumCompleted >= NumJobs; });
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+    TestTrue(TEXT("All jobs finish before the timeout"), bFinished);
+    TestEqual(TEXT("Every job completes exactly once"), NumCompleted, NumJobs);
+    TestEqual(TEXT("Every job reaches the runner once"), Runner->GetRequestCount(), static_cast<int64>(NumJobs));
+    TestEqual(TEXT("No job completes without a response"), NumEmpty, 0);
+    TestFalse(TEXT("Queue is idle afterwards"), Queue->IsBusy());
+
+    AddInfo(FString::Printf(TEXT("%d jobs in %.1f ms (%.0f jobs/s)."), NumJobs, ElapsedSeconds * 1000.0, NumJobs / FMath::Max(ElapsedSeconds, UE_DOUBLE_SMALL_NUMBER)));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameDirectorJobQueueOrderingTest, "GameDirector.JobQueue.Ordering",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGameDirectorJobQueueOrderingTest::RunTest(const FString& Parameters)
+{
+    using namespace GameDirectorJobQueueTest;
+
+    // One worker and a slow runner: the first job holds the worker while the rest queue up behind it.
+    FMockLlamaRunnerSettings Settings;
+    Settings.LatencyMs = 50.0f;
+
+    const TSharedPtr<FMockLlamaRunner> Runner = MakeShared<FMockLlamaRunner>(Settings);
+    const TSharedPtr<FGameDirectorJobQueue> Queue = MakeShared<FGameDirectorJobQueue>(Runner, 1);
+
+    TArray<FName> Order;
+    const auto Enqueue = [&Queue, &Order](const TCHAR* Name, FGameDirectorJob::EPriority Priority)
+    {
+        const FName ComponentId(Name);
+        Queue->EnqueueJob(MakeJob(ComponentId, Priority, [&Order, ComponentId](const FString&) { Order.Add(ComponentId); }));
+    };
+
+    Enqueue(TEXT("Running"), FGameDirectorJob::EPriority::Low);
+    Enqueue(TEXT("Low"), FGameDirectorJob::EPriority::Low);
+    Enqueue(TEXT("Normal1"), FGameDirectorJob::EPriority::Normal);
+    Enqueue(TEXT("Normal2"), FGameDirectorJob::EPriority::Normal);
+    Enqueue(TEXT("High"), FGameDirectorJob::EPriority::High);
+    Enqueue(TEXT("Normal3"), FGameDirectorJob::EPriority::Normal);
+
+    const TArray<FName> Expected = { TEXT("Running"), TEXT("High"), TEXT("Normal1"), TEXT("Normal2"), TEXT("Normal3"), TEXT("Low") };
+
+    TestTrue(TEXT("All jobs finish before the timeout"), PumpUntil(*Queue, [&Order, &Expected]() { return Order.Num() >= Expected.Num(); }));
+    TestEqual(TEXT("Completion count"), Order.Num(), Expected.Num());
+
+    for (int32 Index = 0; Index < FMath::Min(Order.Num(), Expected.Num()); ++Index)
+    {
+        TestEqual(FString::Printf(TEXT("Job %d"), Index), Order[Index], Expected[Index]);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameDirectorJobQueueCancelTest, "GameDirector.JobQueue.Cancel",
+    EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FGameDirectorJobQueueCancelTest::RunTest(const FString& Parameters)
+{
+    using namespace GameDirectorJobQueueTest;
+
+    constexpr int32 NumCancelled = 10;
+    constexpr int32 NumKept = 5;
+
+    FMockLlamaRunnerSettings Settings;
+    Settings.LatencyMs = 20.0f;
+
+    const TSharedPtr<FMockLlamaRunner> Runner = MakeShared<FMockLlamaRunner>(Settings);
+    const TSharedPtr<FGameDirectorJobQueue> Queue = MakeShared<FGameDirectorJobQueue>(Runner, 1);
+
+    int32 RunningCompleted = 0;
+    int32 CancelledCompleted = 0;
+    int32 KeptCompleted = 0;
+
+    Queue->EnqueueJob(MakeJob(TEXT("Running"), FGameDirectorJob::EPriority::Normal, [&RunningCompleted](const FString&) { ++RunningCompleted; }));
+    for (int32 Index = 0; Index < NumCancelled; ++Index)
+    {
+        Queue->EnqueueJob(MakeJob(TEXT("Cancelled"), FGameDirectorJob::EPriority::High, [&CancelledCompleted](const FString&) { ++CancelledCompleted; }));
+    }
+    for (int32 Index = 0; Index < NumKept; ++Index)
+    {
+        Queue->EnqueueJob(MakeJob(TEXT("Kept"), FGameDirectorJob::EPriority::Normal, [&KeptCompleted](const FString&) { ++KeptCompleted; }));
+    }
+
+    TestEqual(TEXT("Pending jobs removed"), Queue->CancelJobs(TEXT("Cancelled")), NumCancelled);
+    TestEqual(TEXT("Running jobs are not cancelled"), Queue->CancelJobs(TEXT("Running")), 0);
+
+    TestTrue(TEXT("Remaining jobs finish before the timeout"), PumpUntil(*Queue, [&]() { return RunningCompleted + KeptCompleted >= 1 + NumKept; }));
+    TestEqual(TEXT("Running job completes"), RunningCompleted, 1);
+    TestEqual(TEXT("Kept jobs complete"), KeptCompleted, NumKept);
+    TestEqual(TEXT("Cancelled callbacks never run"), CancelledCompleted, 0);
+    TestEqual(TEXT("Cancelled jobs never reach the runner"), Runner->GetRequestCount(), static_cast<int64>(1 + NumKept));
+    TestFalse(TEXT("Queue is idle afterwards"), Queue->IsBusy());
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -2,15 +2,26 @@
 
 #include "CoreMinimal.h"
 #include "AIController.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "GameDirectorTypes.h"
 
 #include "AICombatController.generated.h"
 
 class UGameDirectorSubsystem;
 class UBlackboardComponent;
+class UBlackboardData;
 
 /**
- * Base AI controller that subscribes to the GameDirector difficulty feed and pushes values to the blackboard.
+ * Base AI controller that follows the GameDirector difficulty snapshots and pushes values to the blackboard.
+ *
+ * The controller does not subscribe to OnDifficultyChanged; it compares snapshot versions on a slow tick (or when
+ * a UBTService_GameDirectorDifficulty asks) and only writes the blackboard when they moved. It follows the global
+ * target (unless bFollowGlobalDifficulty is off) plus its archetype, squad and region targets; whichever of those
+ * was published last wins, and with none active it keeps DefaultDifficulty limited by the director's load caps. A
+ * change of caps re-syncs it like a new snapshot would.
+ *
+ * Blackboard keys are resolved to IDs once per blackboard asset. Only values that differ from the last push are
+ * written, and observers are notified after the whole batch instead of once per key.
  */
 UCLASS()
 class GAMEDIRECTOR_API AAICombatController : public AAIController
@@ -24,6 +35,7 @@ public:
     virtual void OnPossess(APawn* InPawn) override;
     virtual void OnUnPossess() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Tick(float DeltaSeconds) override;
 
     /** Apply difficulty adjustments provided by the subsystem. */
     UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
@@ -33,16 +45,26 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
     virtual void ResetDifficulty();
 
+    /** Applies the latest snapshot of this controller's targets if it changed since the last sync. Returns true if it was applied. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
+    bool SyncDifficulty();
+
+    /** Moves the controller to another squad target; NAME_None leaves squads. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
+    void SetDifficultySquad(FName InSquad);
+
+    /** Moves the controller to another region target, e.g. when its pawn crosses a volume; NAME_None leaves regions. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
+    void SetDifficultyRegion(FName InRegion);
+
 protected:
-    /** Pushes the cached difficulty to the blackboard for consumption by behavior tree services. */
+    /** Pushes the changed fields of the cached difficulty to the blackboard for consumption by behavior tree services. */
     virtual void PushToBlackboard();
 
-    /** Handles broadcast from the subsystem. */
-    UFUNCTION()
-    void OnSubsystemDifficultyChanged(const FAIDifficulty& InDiff);
+    /** Looks the key names up in the component's current blackboard asset and forces the next push to write every key. */
+    void ResolveBlackboardKeys(const UBlackboardComponent& BlackboardComp);
 
-    void RegisterWithSubsystem();
-    void UnregisterFromSubsystem();
+    UGameDirectorSubsystem* GetSubsystem();
 
 protected:
     //{"schema": "gda.fps.output.v1", "intent": "tune_difficulty", "reason": "Easing pressure due to fast player deaths.", "tool_calls": [{"name": "AdjustAIDifficulty", "args": {"aim_spread_level": 2, "aim_spread_fine": 0.05, "reaction_level": 1, "aggression_level": 1, "peek_level": 1, "duration_s": 60}}]}
@@ -65,7 +87,7 @@ protected:
     FName aggression_level;
 
 
-    /** Default values that will be restored whenever timers expire. */
+    /** Default values that will be restored whenever timers expire; load caps still apply on top. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI")
     FAIDifficulty DefaultDifficulty;
 
@@ -73,8 +95,57 @@ protected:
     UPROPERTY(VisibleInstanceOnly, Category = "GameDirector|AI")
     FAIDifficulty CachedDifficulty;
 
+    /** Archetype target name ("grunt", "boss"), addressed by the director as archetype:<name>. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|AI|Targeting")
+    FName DifficultyArchetype;
+
+    /** Squad target name, addressed as squad:<name>. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|AI|Targeting")
+    FName DifficultySquad;
+
+    /** Region target name, addressed as region:<name>. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|AI|Targeting")
+    FName DifficultyRegion;
+
+    /** Apply global ("all") updates. Off for AI whose tuned defaults should only change when addressed directly. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|AI|Targeting")
+    bool bFollowGlobalDifficulty = true;
+
+    /** Seconds between snapshot version checks. 0 disables them; sync from a behavior tree service instead. */
+    UPROPERTY(EditDefaultsOnly, Category = "GameDirector|AI")
+    float DifficultySyncInterval = 0.5f;
+
 private:
     TWeakObjectPtr<UGameDirectorSubsystem> CachedSubsystem;
+
+    struct FDifficultyBlackboardKeys
+    {
+        FBlackboard::FKey AggressionLevel = FBlackboard::InvalidKey;
+        FBlackboard::FKey ReactionLevel = FBlackboard::InvalidKey;
+        FBlackboard::FKey PeekLevel = FBlackboard::InvalidKey;
+        FBlackboard::FKey AimSpreadFine = FBlackboard::InvalidKey;
+        FBlackboard::FKey AimSpreadLevel = FBlackboard::InvalidKey;
+        FBlackboard::FKey DurationS = FBlackboard::InvalidKey;
+    };
+
+    FDifficultyBlackboardKeys BlackboardKeys;
+
+    /** Asset BlackboardKeys were resolved against; a different asset triggers a new lookup. */
+    TWeakObjectPtr<const UBlackboardData> BlackboardKeysAsset;
+
+    /** Values last written to the blackboard; unset until the first push after resolving keys. */
+    TOptional<FAIDifficulty> PushedDifficulty;
+
+    /** Subsystem handles of the targets above, resolved on the next sync when empty. */
+    TArray<int32, TInlineAllocator<4>> DifficultyTargetHandles;
+
+    /** Snapshot version last applied (0 = defaults), INDEX_NONE to force the next sync. */
+    int32 AppliedDifficultyVersion = INDEX_NONE;
+
+    /** Load caps version DefaultDifficulty was last capped with. */
+    int32 AppliedLoadCapsVersion = INDEX_NONE;
+
+    float TimeUntilDifficultySync = 0.0f;
 };
 
 /** Lightweight variant for grunt enemies. */
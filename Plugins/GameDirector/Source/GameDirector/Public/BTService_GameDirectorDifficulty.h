@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTService.h"
+
+#include "BTService_GameDirectorDifficulty.generated.h"
+
+/**
+ * Pulls the GameDirector difficulty snapshot into the owning AAICombatController's blackboard while the branch is
+ * active. Lets behavior trees refresh difficulty exactly where they read it, with controller ticking disabled.
+ */
+UCLASS(meta = (DisplayName = "Sync GameDirector Difficulty"))
+class GAMEDIRECTOR_API UBTService_GameDirectorDifficulty : public UBTService
+{
+    GENERATED_BODY()
+
+public:
+    UBTService_GameDirectorDifficulty();
+
+protected:
+    virtual void OnBecomeRelevant(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+    virtual void TickNode(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+
+private:
+    static void Sync(UBehaviorTreeComponent& OwnerComp);
+};
@@ -2,16 +2,20 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "GameDirectorSignificance.h"
 #include "GameDirectorTypes.h"
 
 #include "EnemyCharacter.generated.h"
 
+struct FGameDirectorEnemyParams;
+enum class EGameDirectorCombatEvent : uint8;
+
 /**
  * Character pawn that reacts to GameDirector difficulty updates and simulates
  * cover peeking and burst firing behaviour.
  */
 UCLASS(BlueprintType, Blueprintable)
-class GAMEDIRECTOR_API AEnemyCharacter : public ACharacter
+class GAMEDIRECTOR_API AEnemyCharacter : public ACharacter, public IGameDirectorSignificant
 {
     GENERATED_BODY()
 
@@ -25,18 +29,34 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GameDirector|Combat")
     void StartShooting();
 
-    /** Stops any active burst firing behaviour and clears timers. */
+    /** Stops any active burst firing behaviour and cancels the pending shot. */
     UFUNCTION(BlueprintCallable, Category = "GameDirector|Combat")
     void StopShooting();
 
-    /** Fires a single simulated shot using the currently configured aim spread. */
+    /**
+     * Fires a single simulated shot using the currently configured aim spread. The trace is batched with the other
+     * enemies' shots by UGameDirectorCombatScheduler and resolved on the next frame.
+     */
     UFUNCTION(BlueprintCallable, Category = "GameDirector|Combat")
     void FireOneShot();
 
-    /** Applies the provided difficulty settings to the character. */
+    /** Receives the async trace result of a shot; Hit is null on a miss. */
+    void OnShotResolved(const FVector& Start, const FVector& End, const FHitResult* Hit);
+
+    /**
+     * Retargets this character's combat parameters to the provided difficulty. The change is eased in by the
+     * world's UGameDirectorDifficultyBlender and holds until the director makes a new global decision; load cap
+     * changes re-evaluate it but keep it.
+     */
     UFUNCTION(BlueprintCallable, Category = "GameDirector|Difficulty")
     void ApplyDifficulty(const FAIDifficulty& Diff);
 
+    /**
+     * Sets the derived combat parameters; called by the blender as they ease. Pending shots and peek toggles pick the
+     * new values up when they next reschedule instead of being restarted.
+     */
+    void SetCombatParams(const FGameDirectorEnemyParams& Params);
+
     /** Toggles between peeking and hiding behaviour. */
     UFUNCTION(BlueprintCallable, Category = "GameDirector|Cover")
     void TogglePeek();
@@ -49,9 +69,16 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GameDirector|Cover")
     void ExitCover();
 
+    //~Begin IGameDirectorSignificant interface
+    virtual void OnSignificanceChanged(EGameDirectorSignificance Significance, const FGameDirectorSignificanceBudget& Budget) override;
+    //~End IGameDirectorSignificant interface
+
 protected:
-    /** Updates the peek timer with the latest interval values. */
-    void RefreshPeekTimer();
+    /** Schedules the next peek toggle using the current interval. */
+    void SchedulePeekToggle();
+
+    /** Queues Event on the world's UGameDirectorCombatScheduler, replacing a pending one of the same kind. */
+    void ScheduleCombatEvent(EGameDirectorCombatEvent Event, float DelaySeconds);
 
     /** Configured reaction delay before firing begins. */
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Difficulty", meta = (AllowPrivateAccess = "true"))
@@ -81,11 +108,11 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|State", meta = (AllowPrivateAccess = "true"))
     bool bIsShooting;
 
-    /** Active timer handle for firing bursts. */
-    FTimerHandle FireTimerHandle;
+    /** Slot in the world's UGameDirectorCombatScheduler that drives firing and peeking. */
+    int32 CombatSlot;
 
-    /** Active timer handle for peeking in and out of cover. */
-    FTimerHandle PeekTimerHandle;
+    /** Limits for the current significance bucket; peek toggles stretch and shot traces stop as it drops. */
+    FGameDirectorSignificanceBudget SignificanceBudget;
 
     /** Number of shots fired in the current burst. */
     int32 ShotsFiredInBurst;
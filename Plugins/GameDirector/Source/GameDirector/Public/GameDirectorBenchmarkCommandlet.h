@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "GameDirectorBenchmarkCommandlet.generated.h"
+
+/**
+ * Replays recorded gda.fps.input.v1 scenarios through FGameDirectorJobQueue without a game world and reports
+ * cold start, time to first token, tokens/s, per-request latency percentiles and JSON validity.
+ *
+ * Usage: -run=GameDirectorBenchmark [-Model=<id or base name>] [-Corpus=<file or dir>] [-Requests=N] [-Concurrency=N]
+ *        [-Warmup=N] [-Paced] [-Output=<file.csv|file.json>] [-Mock [-MockLatencyMs=N] [-MockLatencySpreadMs=N]]
+ *
+ * The corpus is either a single .json scenario, an .ndjson/.jsonl file with one scenario per line, a
+ * FGameDirectorRecorder log, or a directory of those. Without -Corpus, Saved/GameDirector/Corpus is used, and a fixed
+ * synthetic set when that is empty. Recorded entries are compared against their original response and latency to
+ * report decision drift; -Paced replays them at their recorded spacing instead of all at once.
+ * -Mock replaces the model with a FMockLlamaRunner to measure the scheduling path alone.
+ */
+UCLASS()
+class GAMEDIRECTOR_API UGameDirectorBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGameDirectorBenchmarkCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
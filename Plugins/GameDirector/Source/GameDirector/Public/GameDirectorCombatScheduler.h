@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "WorldCollision.h"
+
+#include "GameDirectorCombatScheduler.generated.h"
+
+class AEnemyCharacter;
+
+/** Recurring per-enemy combat events driven by UGameDirectorCombatScheduler. */
+enum class EGameDirectorCombatEvent : uint8
+{
+    Fire,
+    PeekToggle,
+    Count
+};
+
+/**
+ * Timing wheel that drives fire and peek events for every AEnemyCharacter in a world.
+ *
+ * Time is quantized to TickResolution; each wheel bucket holds the events due on the ticks that map to it, so
+ * scheduling is an append and each frame only visits the buckets it crosses. An enemy has at most one pending event of
+ * each kind: rescheduling or cancelling bumps a per-slot generation and the stale entry is dropped when its bucket
+ * comes up. At most MaxEventsPerFrame events are dispatched per frame; the rest run on the following frames.
+ *
+ * Shot traces are gathered the same way: QueueShot only records the ray, the frame's shots are submitted together as
+ * async line traces after dispatch, and their results are handed back to the enemies on the next frame.
+ */
+UCLASS(config = Game)
+class GAMEDIRECTOR_API UGameDirectorCombatScheduler : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // --- Tickable interface ---
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override { return NumPending > 0 || QueuedShots.Num() > 0 || InFlightShots.Num() > 0; }
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UGameDirectorCombatScheduler, STATGROUP_Tickables);
+    }
+
+    /** Returns the slot used to address the enemy in the calls below. */
+    int32 RegisterEnemy(AEnemyCharacter* Enemy);
+
+    /** Frees the slot and drops its pending events. */
+    void UnregisterEnemy(int32 Slot);
+
+    /** Schedules Event for the enemy DelaySeconds from now, replacing a pending event of the same kind. */
+    void Schedule(int32 Slot, EGameDirectorCombatEvent Event, float DelaySeconds);
+
+    void Cancel(int32 Slot, EGameDirectorCombatEvent Event);
+
+    /** Queues a visibility trace for a shot; the enemy receives OnShotResolved on the frame after submission. */
+    void QueueShot(AEnemyCharacter* Enemy, const FVector& Start, const FVector& End);
+
+    /** Returns the scheduler of the context object's world, or nullptr. */
+    static UGameDirectorCombatScheduler* Get(const UObject* WorldContextObject);
+
+    /** Wheel granularity in seconds; events fire on the first frame at or after their quantized due time. */
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Combat")
+    float TickResolution = 1.0f / 60.0f;
+
+    /** Upper bound on events dispatched per frame. 0 disables the cap. */
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Combat")
+    int32 MaxEventsPerFrame = 128;
+
+private:
+    static constexpr int32 NumEventTypes = static_cast<int32>(EGameDirectorCombatEvent::Count);
+
+    /** Power of two so bucket lookup is a mask; 512 ticks covers ~8.5 s at 60 Hz, longer delays wrap and wait. */
+    static constexpr int32 WheelSize = 512;
+
+    struct FEvent
+    {
+        int64 DueTick = 0;
+        int32 Slot = INDEX_NONE;
+        uint32 Generation = 0;
+        EGameDirectorCombatEvent Type = EGameDirectorCombatEvent::Fire;
+    };
+
+    struct FShot
+    {
+        TWeakObjectPtr<AEnemyCharacter> Enemy;
+        FVector Start = FVector::ZeroVector;
+        FVector End = FVector::ZeroVector;
+        FTraceHandle Handle;
+    };
+
+    void Dispatch(const FEvent& Event);
+
+    /** Hands last frame's finished traces back to their enemies. */
+    void ResolveShots();
+
+    /** Submits the shots queued this frame as one batch of async traces. */
+    void SubmitShots();
+
+    uint32& GetGeneration(int32 Slot, EGameDirectorCombatEvent Event) { return Generations[Slot * NumEventTypes + static_cast<int32>(Event)]; }
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AEnemyCharacter>> Enemies;
+
+    /** NumEventTypes entries per slot; only events carrying the current generation are live. */
+    TArray<uint32> Generations;
+
+    TArray<int32> FreeSlots;
+
+    TArray<TArray<FEvent>> Buckets;
+
+    /** Seconds since the scheduler started. */
+    double ElapsedSeconds = 0.0;
+
+    /** Every tick before this one has been fully dispatched. */
+    int64 NextTick = 0;
+
+    /** Events in the wheel, stale ones included. */
+    int32 NumPending = 0;
+
+    TArray<FShot> QueuedShots;
+    TArray<FShot> InFlightShots;
+};
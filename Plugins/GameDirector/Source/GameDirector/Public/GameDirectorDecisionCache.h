@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameDirectorScenario.h"
+#include "GameDirectorTypes.h"
+
+/**
+ * Nearest-neighbour cache of LLM difficulty decisions.
+ *
+ * Each scenario is embedded as a short float vector: the compact fields scaled to roughly [-1, 1] around a typical
+ * fight, plus a constant bias lane so scenarios on the same ray from that centre are not treated as identical. Vectors
+ * are normalized on insert, so the cosine similarity against a query is a dot product; lookups scan the whole ring
+ * with 4-wide vector math, which for a few hundred entries costs less than building any index over them.
+ *
+ * A lookup returns the decision of the most similar entry when it clears the similarity threshold and is younger than
+ * the maximum age. Game thread only.
+ */
+class GAMEDIRECTOR_API FGameDirectorDecisionCache
+{
+public:
+    FGameDirectorDecisionCache();
+
+    /** Drops every entry and resizes the ring. Capacity 0 disables the cache. */
+    void Reset(int32 InCapacity);
+
+    /** Stores Decision for Scenario, replacing the oldest entry once full. */
+    void Add(const FGameDirectorScenario& Scenario, const FAIDifficulty& Decision, double NowSeconds);
+
+    /**
+     * Looks up the closest cached scenario. Returns true and fills OutDecision when its cosine similarity is at least
+     * MinSimilarity and it was added within MaxAgeSeconds (0 = no age limit).
+     */
+    bool Find(const FGameDirectorScenario& Scenario, float MinSimilarity, double MaxAgeSeconds, double NowSeconds, FAIDifficulty& OutDecision, float& OutSimilarity);
+
+    int32 Num() const { return NumEntries; }
+    int32 GetHits() const { return Hits; }
+    int32 GetMisses() const { return Misses; }
+
+private:
+    static constexpr int32 NumFeatures = static_cast<int32>(FGameDirectorScenario::ECompactField::Count);
+
+    /** Features plus the bias lane, padded to whole vector registers. */
+    static constexpr int32 Stride = Align(NumFeatures + 1, 4);
+
+    static void Embed(const FGameDirectorScenario& Scenario, float* OutVector);
+
+    /** Entry-major embeddings, Stride floats each. */
+    TArray<float, TAlignedHeapAllocator<16>> Vectors;
+    TArray<FAIDifficulty> Decisions;
+    TArray<double> AddedSeconds;
+
+    int32 Capacity = 0;
+    int32 NumEntries = 0;
+    int32 NextSlot = 0;
+    int32 Hits = 0;
+    int32 Misses = 0;
+};
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "GameDirectorDifficultyCurves.h"
+#include "GameDirectorTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+
+#include "GameDirectorDifficultyBlender.generated.h"
+
+class AEnemyCharacter;
+class UGameDirectorSubsystem;
+
+/** Combat parameters an AEnemyCharacter derives from a FAIDifficulty. */
+struct GAMEDIRECTOR_API FGameDirectorEnemyParams
+{
+    float ReactionDelay = 1.5f;
+    float AimSpread = 5.0f;
+    float FireRate = 1.0f;
+    float BurstCount = 3.0f;
+    float PeekInterval = 3.0f;
+};
+
+/**
+ * Eases the combat parameters of every registered AEnemyCharacter towards their difficulty target.
+ *
+ * Parameters live in one array per field; each frame a single pass moves all of them a fixed fraction of the way to
+ * their targets and writes the result back only to the enemies whose parameters moved. Enemies follow the global
+ * difficulty snapshot of UGameDirectorSubsystem; AEnemyCharacter::ApplyDifficulty overrides a single enemy until the
+ * director makes a new global decision. Republishes caused by load cap changes re-evaluate every target, overrides
+ * included, without dropping them. Nothing ticks once every enemy has converged.
+ *
+ * Difficulty levels are mapped to parameters through a FGameDirectorDifficultyTable baked from DifficultyCurves.
+ */
+UCLASS(config = Game)
+class GAMEDIRECTOR_API UGameDirectorDifficultyBlender : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // --- Tickable interface ---
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override { return Enemies.Num() > 0; }
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UGameDirectorDifficultyBlender, STATGROUP_Tickables);
+    }
+
+    /** Adds an enemy starting from Params; it snaps to the current global difficulty if one was published. */
+    void RegisterEnemy(AEnemyCharacter* Enemy, const FGameDirectorEnemyParams& Params);
+
+    void UnregisterEnemy(AEnemyCharacter* Enemy);
+
+    /** Starts easing one enemy towards Difficulty. */
+    void SetTarget(AEnemyCharacter* Enemy, const FAIDifficulty& Difficulty);
+
+    /** Returns the blender of the context object's world, or nullptr. */
+    static UGameDirectorDifficultyBlender* Get(const UObject* WorldContextObject);
+
+    /** Level to parameter lookup currently in use. */
+    const FGameDirectorDifficultyTable& GetTable() const { return Table; }
+
+    /** Curves baked into the lookup table when the world starts. Unset uses the built-in mapping. */
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Difficulty")
+    TSoftObjectPtr<UGameDirectorDifficultyCurves> DifficultyCurves;
+
+    /** Seconds for a parameter to cover ~63% of the way to its target. 0 snaps immediately. */
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Difficulty")
+    float BlendTimeConstant = 1.5f;
+
+private:
+    enum EParam : uint8
+    {
+        ReactionDelay,
+        AimSpread,
+        FireRate,
+        BurstCount,
+        PeekInterval,
+        NumParams
+    };
+
+    void SetTargetAt(int32 Index, const FGameDirectorEnemyParams& Params);
+    void SetCurrentAt(int32 Index, const FGameDirectorEnemyParams& Params);
+    FGameDirectorEnemyParams GetCurrentAt(int32 Index) const;
+    void RemoveAtSwap(int32 Index);
+    void FollowGlobalDifficulty();
+
+    /** Targets every enemy at Global, or at its own override if it has one. */
+    void RetargetAll(const FAIDifficulty& Global);
+
+    const UGameDirectorSubsystem* GetDirector() const;
+
+    /** Table lookup with the fire rate limited by the director's load caps. */
+    FGameDirectorEnemyParams Evaluate(const FAIDifficulty& Difficulty) const;
+    void BakeTable();
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AEnemyCharacter>> Enemies;
+
+    TMap<const AEnemyCharacter*, int32> IndexByEnemy;
+
+    TStaticArray<TArray<float>, NumParams> Current;
+    TStaticArray<TArray<float>, NumParams> Target;
+
+    /** Per-enemy difficulty set through SetTarget; only meaningful where HasOverride is set. */
+    TArray<FAIDifficulty> Overrides;
+    TBitArray<> HasOverride;
+
+    /** Scratch for Tick: enemies whose parameters moved this frame. */
+    TBitArray<> Moved;
+
+    FGameDirectorDifficultyTable Table;
+
+#if WITH_EDITOR
+    FDelegateHandle CurvesChangedHandle;
+#endif
+
+    /** Global snapshot version last pushed to the targets. */
+    int32 AppliedGlobalVersion = 0;
+
+    /** Pre-cap global decision and load caps version behind AppliedGlobalVersion; tell a new decision from a cap change. */
+    FAIDifficulty AppliedGlobalDifficulty;
+    int32 AppliedLoadCapsVersion = 0;
+
+    bool bBlending = false;
+};
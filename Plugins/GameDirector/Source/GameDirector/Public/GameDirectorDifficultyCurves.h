@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "Curves/CurveFloat.h"
+#include "Engine/DataAsset.h"
+
+#include "GameDirectorDifficultyCurves.generated.h"
+
+struct FAIDifficulty;
+struct FGameDirectorEnemyParams;
+class UGameDirectorDifficultyCurves;
+
+/**
+ * FAIDifficulty levels baked into per-level lookup arrays, so mapping a difficulty to enemy combat parameters is a
+ * handful of indexed loads. Built from a UGameDirectorDifficultyCurves asset, or from the built-in defaults.
+ */
+struct GAMEDIRECTOR_API FGameDirectorDifficultyTable
+{
+    /** Levels 0..10, the range UGameDirectorSubsystem clamps model output to. */
+    static constexpr int32 NumLevels = 11;
+
+    TStaticArray<float, NumLevels> ReactionDelayByLevel;
+    TStaticArray<float, NumLevels> AimSpreadByLevel;
+    TStaticArray<float, NumLevels> FireRateByLevel;
+    TStaticArray<float, NumLevels> BurstCountByLevel;
+    TStaticArray<float, NumLevels> PeekIntervalByLevel;
+
+    /** Bounds applied after AimSpreadFine is added to the level's spread. */
+    float MinAimSpread = 0.5f;
+    float MaxAimSpread = 8.0f;
+
+    FGameDirectorEnemyParams Evaluate(const FAIDifficulty& Difficulty) const;
+
+    /** Samples every curve of Curves at each level; curves without keys keep the built-in values. */
+    static FGameDirectorDifficultyTable Bake(const UGameDirectorDifficultyCurves* Curves);
+
+    /** Table matching the original hard-coded formulas. */
+    static const FGameDirectorDifficultyTable& Default();
+};
+
+/**
+ * Designer-tunable mapping from AdjustAIDifficulty levels to enemy combat parameters. Each curve is sampled at the
+ * integer levels 0..10 when the asset is loaded; only the keys in that range matter.
+ */
+UCLASS(BlueprintType)
+class GAMEDIRECTOR_API UGameDirectorDifficultyCurves : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    /** Seconds before an enemy starts firing, by reaction_level. */
+    UPROPERTY(EditAnywhere, Category = "Difficulty")
+    FRuntimeFloatCurve ReactionDelay;
+
+    /** Aim cone half-angle in degrees, by aim_spread_level. aim_spread_fine is added on top. */
+    UPROPERTY(EditAnywhere, Category = "Difficulty")
+    FRuntimeFloatCurve AimSpread;
+
+    UPROPERTY(EditAnywhere, Category = "Difficulty")
+    float MinAimSpread = 0.5f;
+
+    UPROPERTY(EditAnywhere, Category = "Difficulty")
+    float MaxAimSpread = 8.0f;
+
+    /** Shots per second, by aggression_level. */
+    UPROPERTY(EditAnywhere, Category = "Difficulty")
+    FRuntimeFloatCurve FireRate;
+
+    /** Shots per burst, by aggression_level; rounded when applied. */
+    UPROPERTY(EditAnywhere, Category = "Difficulty")
+    FRuntimeFloatCurve BurstCount;
+
+    /** Seconds between peek and hide toggles, by peek_level. */
+    UPROPERTY(EditAnywhere, Category = "Difficulty")
+    FRuntimeFloatCurve PeekInterval;
+
+#if WITH_EDITOR
+    /** Fired after any curve asset is edited so running blenders can re-bake. */
+    static TMulticastDelegate<void(const UGameDirectorDifficultyCurves*)> OnCurvesChanged;
+
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
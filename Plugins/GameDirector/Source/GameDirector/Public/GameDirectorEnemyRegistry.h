@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+
+#include "GameDirectorEnemyRegistry.generated.h"
+
+/**
+ * Dense registry of the enemies alive in a world, kept incrementally as they begin and end play.
+ *
+ * Positions are stored as separate X/Y/Z arrays parallel to the actor array so scenario queries are a single
+ * branch-free pass the compiler can vectorize. Removal swaps the last entry into the freed slot, so indices are not
+ * stable across Unregister calls.
+ */
+UCLASS()
+class GAMEDIRECTOR_API UGameDirectorEnemyRegistry : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    /** Adds an enemy. Registering the same actor twice is a no-op. */
+    void RegisterEnemy(AActor* Enemy);
+
+    /** Removes an enemy; safe to call for actors that were never registered. */
+    void UnregisterEnemy(AActor* Enemy);
+
+    int32 Num() const { return Enemies.Num(); }
+
+    /** Copies the current actor locations into the position arrays. */
+    void RefreshPositions();
+
+    /** Mean distance from Origin using the positions captured by the last RefreshPositions; 0 when empty. */
+    float ComputeAverageDistance(const FVector& Origin) const;
+
+    /** Returns the registry of the context object's world, or nullptr. */
+    static UGameDirectorEnemyRegistry* Get(const UObject* WorldContextObject);
+
+private:
+    void RemoveAtSwap(int32 Index);
+
+    /** Removes the slot's entries from the parallel arrays only; IndexByEnemy is left to the caller. */
+    void RemoveSlotAtSwap(int32 Index);
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AActor>> Enemies;
+
+    /** Keyed by object key, not address, so a new actor allocated where a collected one lived is not mistaken for it. */
+    TMap<TObjectKey<AActor>, int32> IndexByEnemy;
+
+    TArray<float> PositionsX;
+    TArray<float> PositionsY;
+    TArray<float> PositionsZ;
+};
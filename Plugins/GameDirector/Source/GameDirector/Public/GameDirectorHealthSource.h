@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+
+#include "GameDirectorHealthSource.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UGameDirectorHealthSource : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * Implemented by player pawns so UGameDirectorService can report player.hp without reflection.
+ */
+class GAMEDIRECTOR_API IGameDirectorHealthSource
+{
+    GENERATED_BODY()
+
+public:
+    /** Remaining health normalized to [0, 1]. */
+    virtual float GetHealthFraction() const = 0;
+};
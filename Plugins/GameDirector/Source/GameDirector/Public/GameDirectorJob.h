@@ -1,6 +1,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameDirectorScenario.h"
+#include "GameDirectorStats.h"
 
 /** Lightweight description of a single inference request handled by the job queue. */
 class GAMEDIRECTOR_API FGameDirectorJob
@@ -15,13 +17,22 @@ public:
 
     FGameDirectorJob();
 
-    FGameDirectorJob(FName InComponentId, const FString& InScenarioJSON, EPriority InPriority = EPriority::Normal);
+    FGameDirectorJob(FName InComponentId, const FGameDirectorScenario& InScenario, EPriority InPriority = EPriority::Normal);
+
+    /** Process-unique ID assigned at enqueue; correlates the job's trace events. */
+    uint64 JobId = 0;
 
     /** Identifier for the component requesting inference (e.g. "Difficulty"). */
     FName ComponentId;
 
-    /** Scenario payload that will be sent to the llama runner. */
-    FString ScenarioJSON;
+    /** Model the job runs against; NAME_None uses the queue's default model. */
+    FName ModelId;
+
+    /** LoRA adapter attached to the model for this job; NAME_None runs the base model. */
+    FName AdapterId;
+
+    /** Scenario that will be rendered into the runner's prompt. */
+    FGameDirectorScenario Scenario;
 
     /** Result payload produced by the inference worker. */
     FString ResultJSON;
@@ -32,6 +43,15 @@ public:
     /** Timestamp when the job was enqueued. */
     FDateTime EnqueueTime;
 
+    /** FPlatformTime::Seconds() at enqueue, used for latency accounting. */
+    double EnqueueSeconds = 0.0;
+
+    /** Time the job spent pending before a worker picked it up, in milliseconds. */
+    double QueueWaitMs = 0.0;
+
+    /** Per-stage runner timings, filled by the worker. */
+    FGameDirectorInferenceStats InferenceStats;
+
     /** Callback invoked on the game thread once the job completes. */
     TFunction<void(const FString&)> OnComplete;
 };
@@ -3,7 +3,8 @@
 #include "CoreMinimal.h"
 #include "GameDirectorJob.h"
 
-class FLlamaRunner;
+class ILlamaRunner;
+class FGameDirectorModelManager;
 
 /**
  * Threaded job queue that schedules inference work on the engine thread pool.
@@ -11,14 +12,27 @@ class FLlamaRunner;
 class GAMEDIRECTOR_API FGameDirectorJobQueue : public TSharedFromThis<FGameDirectorJobQueue>
 {
 public:
-    explicit FGameDirectorJobQueue(const TSharedPtr<FLlamaRunner>& InRunner, int32 InMaxConcurrentJobs = 2);
+    /** Creates a queue that runs every job on a single runner (e.g. a FMockLlamaRunner). */
+    explicit FGameDirectorJobQueue(const TSharedPtr<ILlamaRunner>& InRunner, int32 InMaxConcurrentJobs = 2);
+
+    /** Creates a queue that resolves runners through the model manager, using DefaultModelId for jobs without a ModelId. */
+    FGameDirectorJobQueue(const TSharedPtr<FGameDirectorModelManager>& InModelManager, FName InDefaultModelId, int32 InMaxConcurrentJobs = 2);
 
     /** Enqueues a new job for background execution. */
     void EnqueueJob(const TSharedPtr<FGameDirectorJob>& Job);
 
-    /** Advances the queue state and dispatches completed jobs back to the game thread. */
+    /**
+     * Drops the pending jobs of a component; their callbacks never run. Jobs already running still complete.
+     * Returns the number of jobs removed.
+     */
+    int32 CancelJobs(FName ComponentId);
+
+    /** Advances the queue state and runs completion callbacks inline. Must be called on the game thread. */
     void Tick();
 
+    /** Limits the time Tick spends on completion callbacks per call; 0 removes the limit. */
+    void SetDispatchBudgetMs(float InBudgetMs) { DispatchBudgetSeconds = FMath::Max(0.0f, InBudgetMs) / 1000.0; }
+
     /** Returns true while there is pending or running work. */
     bool IsBusy() const;
 
@@ -26,11 +40,16 @@ private:
     void TryStartJobs();
     void StartJob(const TSharedPtr<FGameDirectorJob>& Job);
     void CompleteJob(const TSharedPtr<FGameDirectorJob>& Job);
+    void DispatchCompletedJobs();
     bool CanStartJob() const;
+    TSharedPtr<ILlamaRunner> ResolveRunner(const FGameDirectorJob& Job) const;
 
 private:
-    TWeakPtr<FLlamaRunner> LlamaRunner;
+    TWeakPtr<ILlamaRunner> LlamaRunner;
+    TWeakPtr<FGameDirectorModelManager> ModelManager;
+    FName DefaultModelId;
     int32 MaxConcurrentJobs = 1;
+    double DispatchBudgetSeconds = 0.0;
 
     mutable FCriticalSection PendingMutex;
     TArray<TSharedPtr<FGameDirectorJob>> PendingJobs;
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+class FLlamaRunner;
+
+/** Memory and latency limits used to pick a quantized variant of a model. */
+struct FGameDirectorModelBudget
+{
+    /** Largest model file that may be loaded, in bytes. 0 disables the limit. */
+    uint64 MaxModelBytes = 0;
+
+    /** Target decode time per generated token in milliseconds. 0 disables the limit. */
+    float MaxDecodeMsPerToken = 0.0f;
+
+    /** Sustained memory bandwidth used to estimate decode time, since CPU decode streams every weight once per token. */
+    float MemoryBandwidthGBps = 20.0f;
+};
+
+/** A registered GGUF file split into base model name and quantization tag (e.g. "Qwen2.5-1.5B" + "Q4_K_M"). */
+struct FGameDirectorModelVariant
+{
+    FName ModelId;
+    FString BaseName;
+    FString Quantization;
+    uint64 FileSizeBytes = 0;
+};
+
+/**
+ * Keeps several GGUF models resident under a shared memory budget and evicts the least recently used ones.
+ * All methods are thread-safe; AcquireRunner may block the calling thread while a model loads. Evicted models that
+ * jobs still hold count against the budget until the last job releases them.
+ */
+class GAMEDIRECTOR_API FGameDirectorModelManager : public TSharedFromThis<FGameDirectorModelManager>
+{
+public:
+    explicit FGameDirectorModelManager(uint64 InMemoryBudgetBytes);
+    ~FGameDirectorModelManager();
+
+    /** Registers every *.gguf file in the directory under its base filename. Returns the number of models found. */
+    int32 DiscoverModels(const FString& ModelsDirectory);
+
+    /** Registers a model file under the given id without loading it. */
+    void RegisterModel(FName ModelId, const FString& ModelPath);
+
+    /** Registers a LoRA adapter that is loaded onto the model whenever it is resident. */
+    void RegisterAdapter(FName ModelId, FName AdapterId, const FString& AdapterPath);
+
+    /** Registers every *.gguf file in the directory as an adapter for the model. Returns the number of adapters found. */
+    int32 DiscoverAdapters(FName ModelId, const FString& AdaptersDirectory);
+
+    /** Returns true if the adapter has been registered for the model. */
+    bool HasAdapter(FName ModelId, FName AdapterId) const;
+
+    /** Returns a loaded runner for the model, loading it and evicting older models as needed. */
+    TSharedPtr<FLlamaRunner> AcquireRunner(FName ModelId);
+
+    /** Starts loading the model on the thread pool so a later AcquireRunner does not stall. */
+    void Prefetch(FName ModelId);
+
+    /** Drops the model from residency. Jobs already holding its runner keep it alive until they finish. */
+    void Evict(FName ModelId);
+
+    /** Releases every resident model. */
+    void EvictAll();
+
+    /** Updates the memory budget and evicts models until the resident set fits. */
+    void SetMemoryBudget(uint64 InMemoryBudgetBytes);
+
+    uint64 GetMemoryBudget() const;
+
+    /**
+     * Sum of llama_model_size for all resident models (or file size estimates while loading), plus evicted models
+     * whose runners are still in use.
+     */
+    uint64 GetResidentBytes() const;
+
+    bool IsRegistered(FName ModelId) const;
+    bool IsResident(FName ModelId) const;
+
+    /** Returns the registered model ids sorted alphabetically. */
+    TArray<FName> GetRegisteredModels() const;
+
+    /** Returns the file path registered for the model, or an empty string. */
+    FString GetModelPath(FName ModelId) const;
+
+    /** Returns every registered variant of the base model (all models if BaseName is empty), largest file first. */
+    TArray<FGameDirectorModelVariant> GetVariants(const FString& BaseName) const;
+
+    /** Picks the largest variant of the base model that fits the budget, or the smallest one if none fits. */
+    FName SelectVariant(const FString& BaseName, const FGameDirectorModelBudget& Budget) const;
+
+    /** Splits a GGUF base filename into model name and quantization tag. The tag is empty for untagged files. */
+    static void SplitModelName(const FString& FileBaseName, FString& OutBaseName, FString& OutQuantization);
+
+    /** Maps a quantization tag such as "Q4_K_M" to its llama_ftype value, or INDEX_NONE if unknown. */
+    static int32 GetQuantizationFileType(const FString& Quantization);
+
+private:
+    /** Loaded weights for one file. Several ids may share it, so the model is mapped only once. */
+    struct FResidentModel
+    {
+        TSharedPtr<FLlamaRunner> Runner;
+        uint64 SizeBytes = 0;
+        double LastUsedTime = 0.0;
+        bool bLoading = false;
+
+        /** Set by the loading thread once Runner is assigned or the load failed; other callers wait on it. */
+        TSharedFuture<void> Loaded;
+    };
+
+    /** Evicted model whose runner a job still holds; its memory stays counted until the runner is released. */
+    struct FRetiredModel
+    {
+        TWeakPtr<FLlamaRunner> Runner;
+        uint64 SizeBytes = 0;
+    };
+
+    void EvictToFit(uint64 IncomingBytes, const FString& KeepPath);
+    void EvictPath(const FString& ModelPath);
+
+    /** Stops counting retired models whose runners have been released. Caller must hold Mutex. */
+    void PurgeReleasedModels();
+
+private:
+    mutable FCriticalSection Mutex;
+
+    /** Model id -> normalized file path. */
+    TMap<FName, FString> ModelPaths;
+
+    /** Normalized model file path -> adapter id -> adapter file path. */
+    TMap<FString, TMap<FName, FString>> AdapterPaths;
+
+    /** Normalized file path -> resident model. */
+    TMap<FString, FResidentModel> ResidentModels;
+
+    TArray<FRetiredModel> RetiredModels;
+
+    uint64 MemoryBudgetBytes = 0;
+    uint64 ResidentBytes = 0;
+};
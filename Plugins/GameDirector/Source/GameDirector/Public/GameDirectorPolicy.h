@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "GameDirectorScenario.h"
+#include "GameDirectorTypes.h"
+
+/** One labelled example for FGameDirectorPolicy: a scenario and the decision the LLM made for it. */
+struct FGameDirectorPolicySample
+{
+    FGameDirectorScenario Scenario;
+    FAIDifficulty Decision;
+};
+
+/**
+ * Distilled difficulty policy: one small CART decision tree per AdjustAIDifficulty output, fitted to recorded LLM
+ * decisions by the GameDirectorTrainPolicy commandlet.
+ *
+ * Features are the quantized compact fields of FGameDirectorScenario, so a prediction is a handful of integer
+ * comparisons per tree. Each leaf stores its majority class and a confidence (majority count / (samples + 1)); the
+ * policy confidence is the lowest leaf confidence across outputs, which the subsystem compares against its threshold
+ * before falling back to the LLM.
+ */
+class GAMEDIRECTOR_API FGameDirectorPolicy
+{
+public:
+    enum class EOutput : uint8
+    {
+        AimSpreadLevel,
+        ReactionLevel,
+        AggressionLevel,
+        PeekLevel,
+        DurationS,
+        Count
+    };
+
+    struct FTrainingSettings
+    {
+        int32 MaxDepth = 6;
+        int32 MinSamplesPerLeaf = 4;
+    };
+
+    /** True once trained or loaded. */
+    bool IsValid() const { return NumTrainingSamples > 0; }
+
+    int32 GetNumTrainingSamples() const { return NumTrainingSamples; }
+
+    /** Predicts a decision for Scenario. Returns false when the policy is not valid. */
+    bool Predict(const FGameDirectorScenario& Scenario, FAIDifficulty& OutDecision, float& OutConfidence) const;
+
+    /** Fits every output tree to Samples, replacing the current policy. */
+    void Train(TConstArrayView<FGameDirectorPolicySample> Samples, const FTrainingSettings& Settings);
+
+    bool Save(const FString& FilePath) const;
+    bool Load(const FString& FilePath);
+
+    static const TCHAR* GetOutputName(EOutput Output);
+    static int32 GetOutputValue(const FAIDifficulty& Decision, EOutput Output);
+
+    /** Reads the first global AdjustAIDifficulty call of a gda.fps.output.v1 response; every level must be present. */
+    static bool ParseDecision(const FString& ResponseJSON, FAIDifficulty& OutDecision);
+
+private:
+    static constexpr int32 NumFeatures = static_cast<int32>(FGameDirectorScenario::ECompactField::Count);
+    static constexpr int32 NumOutputs = static_cast<int32>(EOutput::Count);
+
+    using FFeatures = TStaticArray<int32, NumFeatures>;
+
+    struct FNode
+    {
+        /** Split feature, or INDEX_NONE for a leaf. Samples with Feature <= Threshold go left. */
+        int32 Feature = INDEX_NONE;
+        float Threshold = 0.0f;
+        int32 Left = INDEX_NONE;
+        int32 Right = INDEX_NONE;
+
+        /** Majority class of the samples reaching this node. */
+        int32 Value = 0;
+        float Confidence = 0.0f;
+
+        /** Mean aim_spread_fine of those samples; only read from the AimSpreadLevel tree. */
+        float MeanFine = 0.0f;
+    };
+
+    static void GetFeatures(const FGameDirectorScenario& Scenario, FFeatures& OutFeatures);
+
+    const FNode& FindLeaf(EOutput Output, const FFeatures& Features) const;
+
+    int32 BuildNode(EOutput Output, const TArray<FFeatures>& Features, TConstArrayView<FGameDirectorPolicySample> Samples,
+        TArray<int32>& Indices, int32 Depth, const FTrainingSettings& Settings);
+
+    TStaticArray<TArray<FNode>, NumOutputs> Trees;
+    int32 NumTrainingSamples = 0;
+};
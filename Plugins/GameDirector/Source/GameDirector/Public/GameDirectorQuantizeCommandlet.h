@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "GameDirectorQuantizeCommandlet.generated.h"
+
+/**
+ * Produces quantized variants of the GameDirector GGUF models with llama_model_quantize.
+ *
+ * Usage: -run=GameDirectorQuantize [-Source=<file or model id>] [-Types=Q4_K_M,Q5_K_M,Q8_0] [-OutDir=<dir>] [-Threads=N] [-Force] [-AllowRequantize]
+ *
+ * Without -Source every untagged, F16 or F32 model under Content/AIModels is quantized. Variants are written as
+ * <BaseName>.<Type>.gguf so the subsystem can select one against the platform budget at runtime.
+ */
+UCLASS()
+class GAMEDIRECTOR_API UGameDirectorQuantizeCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGameDirectorQuantizeCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FArchive;
+
+/** One recorded GameDirector request: the scenario sent, the raw model response and how long it took. */
+struct FGameDirectorRecordEntry
+{
+    /** Seconds from the start of the recording session to when the request was issued. */
+    double TimeSeconds = 0.0;
+
+    FName ComponentId;
+    FName AdapterId;
+
+    /** gda.fps.input.v1 payload as sent to the model. */
+    FString ScenarioJSON;
+
+    /** Raw model output; may be empty or malformed. */
+    FString ResponseJSON;
+
+    /** Request to callback latency in milliseconds. */
+    double LatencyMs = 0.0;
+};
+
+/**
+ * Appends GameDirector requests to an NDJSON log, one object per line:
+ * {"t":12.5,"component":"Difficulty","adapter":"None","latency_ms":412.3,"scenario":{...},"response":"..."}
+ *
+ * The scenario is stored as a JSON object and the response as a string so malformed output round-trips. Logs are
+ * read back by LoadRecording, which the benchmark commandlet uses to replay production workloads.
+ */
+class GAMEDIRECTOR_API FGameDirectorRecorder
+{
+public:
+    FGameDirectorRecorder();
+    ~FGameDirectorRecorder();
+
+    /** Opens (or appends to) the log file. Returns false if it cannot be created. */
+    bool Open(const FString& InFilePath);
+
+    void Close();
+
+    bool IsOpen() const;
+
+    /** Appends one entry. TimeSeconds is filled from the session clock when left at 0. Thread-safe. */
+    void Record(const FGameDirectorRecordEntry& Entry);
+
+    /** Seconds since Open, used to timestamp entries. */
+    double GetSessionTime() const;
+
+    const FString& GetFilePath() const { return FilePath; }
+
+    /** Saved/GameDirector/Recordings/<Prefix>-<timestamp>.ndjson */
+    static FString MakeSessionFilePath(const FString& Prefix);
+
+    /** Reads every entry of a log written by Record. Lines that fail to parse are skipped. */
+    static bool LoadRecording(const FString& InFilePath, TArray<FGameDirectorRecordEntry>& OutEntries);
+
+    /** Parses a single NDJSON line. */
+    static bool ParseLine(const FString& Line, FGameDirectorRecordEntry& OutEntry);
+
+private:
+    FString FilePath;
+    TUniquePtr<FArchive> Writer;
+    double SessionStartSeconds = 0.0;
+    mutable FCriticalSection Mutex;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Typed gda.fps.input.v1 scenario handed from gameplay to the inference runner.
+ *
+ * Jobs carry this struct instead of a JSON string. Runners render it with the compact "key=value" form described by
+ * ECompactField; each field is quantized to a small integer so FLlamaRunner can reuse cached token IDs for it.
+ * ToJSON/FromJSON remain for recordings, logs and string-based callers.
+ */
+struct GAMEDIRECTOR_API FGameDirectorScenario
+{
+    /** Fields of the compact rendering, in prompt order. */
+    enum class ECompactField : uint8
+    {
+        Health,         // hp: player health, percent
+        EnemyCount,     // en: enemies alive
+        EnemyDistance,  // dist: mean enemy distance, meters
+        DamageTaken,    // dtk: damage taken per second
+        DamageDealt,    // ddl: damage dealt per second
+        HitRatio,       // hit: hit ratio, percent
+        Kills,          // k: kills in the telemetry window
+        Deaths,         // d: deaths in the telemetry window
+        SinceDeath,     // sd: seconds since the last death, -1 if none
+        GameThreadMs,   // gt: smoothed game thread time, ms
+        AIMs,           // ai: smoothed game thread time spent in AI, tenths of a ms
+        Actors,         // act: live actors in the world
+        Count
+    };
+
+    /** Player health normalized to [0, 1]. */
+    float PlayerHealth = 1.0f;
+
+    int32 EnemyCount = 0;
+
+    /** Mean distance from the player to the enemies, in centimeters. */
+    float AvgEnemyDistance = 0.0f;
+
+    /** True when the windowed combat fields below were filled from UGameDirectorTelemetry. */
+    bool bHasTelemetry = false;
+
+    float DamageTakenPerSecond = 0.0f;
+    float DamageDealtPerSecond = 0.0f;
+    float HitRatio = 0.0f;
+    int32 Kills = 0;
+    int32 Deaths = 0;
+    float TimeSinceLastDeath = -1.0f;
+
+    /** True when the server load fields below were filled by UGameDirectorService. */
+    bool bHasServerLoad = false;
+
+    /** Smoothed game thread time per frame, in milliseconds. */
+    float GameThreadMs = 0.0f;
+
+    /** Smoothed part of GameThreadMs spent in GameDirector AI, in milliseconds. */
+    float AIMs = 0.0f;
+
+    int32 ActorCount = 0;
+
+    /** True if the compact form renders the field; telemetry and server load fields are omitted when not captured. */
+    bool HasCompactField(ECompactField Field) const;
+
+    /** Quantized integer value of a compact field. */
+    int32 GetCompactValue(ECompactField Field) const;
+
+    /** Key used for the field in the compact form, e.g. "hp". */
+    static const ANSICHAR* GetCompactKey(ECompactField Field);
+
+    /** "hp=42 en=5 dist=12 ..." - the text the runner's prompt tokens represent. */
+    FString ToCompactString() const;
+
+    /** gda.fps.input.v1 JSON, as recorded and replayed by FGameDirectorRecorder. */
+    FString ToJSON() const;
+
+    /** Parses a gda.fps.input.v1 payload. Missing fields keep their defaults; returns false on malformed JSON. */
+    static bool FromJSON(const FString& JSON, FGameDirectorScenario& OutScenario);
+};
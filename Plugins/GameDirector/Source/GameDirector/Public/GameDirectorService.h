@@ -3,9 +3,12 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Tickable.h"
+#include "GameDirectorTypes.h"
+#include "GameDirectorScenario.h"
 #include "GameDirectorService.generated.h"
 
 class UGameDirectorSubsystem;
+class FGameDirectorRecorder;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogGameDirectorService, Log, All);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDirectorEvaluated, const FString&, ResultJSON);
@@ -34,25 +37,132 @@ public:
     UFUNCTION(BlueprintCallable, Category = "GameDirector")
     void EvaluateDifficulty();
 
+    /**
+     * Captures the current scenario. Telemetry fields are filled when the player controller has a UGameDirectorTelemetry
+     * component, including between death and respawn.
+     */
+    FGameDirectorScenario BuildScenario() const;
+
+    /** BuildScenario rendered as gda.fps.input.v1 JSON. */
     UFUNCTION(BlueprintCallable, Category = "GameDirector")
     FString BuildScenarioJSON() const;
 
+    /** Adds Weight(Event) * Magnitude to the dirty score; see bEventDrivenEvaluation. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector")
+    void ReportEvent(EGameDirectorEvent Event, float Magnitude = 1.0f);
+
+    /** Reports an event to the service of the context object's world, if there is one. */
+    static void ReportEvent(const UObject* WorldContextObject, EGameDirectorEvent Event, float Magnitude = 1.0f);
+
+    /** Accumulated change since the last evaluation. */
+    float GetDirtyScore() const { return DirtyScore; }
+
+    /**
+     * Smoothed game thread time per frame (GGameThreadTime, the "Game" row of stat unit), in milliseconds. Excludes
+     * idle time and waits on the render thread or GPU. 0 unless bTrackServerLoad is set.
+     */
+    float GetGameThreadMs() const { return SmoothedGameThreadMs; }
+
+    /** Smoothed game thread time spent in this world's GameDirector AI (see FGameDirectorAITimeScope), in milliseconds. */
+    float GetAIMs() const { return SmoothedAIMs; }
+
+    /** Adds AI time to the current frame; usually through FGameDirectorAITimeScope. Game thread only. */
+    void AddAITime(double Seconds) { FrameAISeconds += Seconds; }
+
+    /** True while OverBudgetCaps are enforced. */
+    bool IsOverBudget() const { return bOverBudget; }
+
     // --- Settings ---
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector")
     bool bEnableAutoEvaluation = true;
 
+    /** Fixed polling period, or the longest gap between evaluations when bEventDrivenEvaluation is set. */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector")
     float EvaluationInterval = 10.0f;
 
+    /** Evaluate when reported events push the dirty score past DirtyThreshold instead of on every interval. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Events")
+    bool bEventDrivenEvaluation = true;
+
+    /** Dirty score at which an evaluation is triggered. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Events", meta = (EditCondition = "bEventDrivenEvaluation"))
+    float DirtyThreshold = 1.0f;
+
+    /** Shortest gap between evaluations, however many events arrive. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Events", meta = (EditCondition = "bEventDrivenEvaluation"))
+    float MinEvaluationInterval = 2.0f;
+
+    /** Dirty score removed per second, so only bursts of events (e.g. damage spikes) trigger an evaluation. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Events", meta = (EditCondition = "bEventDrivenEvaluation"))
+    float DirtyDecayPerSecond = 0.05f;
+
+    /** Dirty score added per event, multiplied by the reported magnitude. Unlisted events are ignored. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Events", meta = (EditCondition = "bEventDrivenEvaluation"))
+    TMap<EGameDirectorEvent, float> EventWeights = {
+        { EGameDirectorEvent::PlayerDeath, 1.0f },
+        { EGameDirectorEvent::PlayerDamaged, 1.5f },
+        { EGameDirectorEvent::EnemySpawned, 0.1f },
+        { EGameDirectorEvent::EnemyDied, 0.2f },
+        { EGameDirectorEvent::TeamScoreChanged, 0.1f },
+    };
+
+    /** Measure game thread and AI time each frame, report them in scenarios and enforce OverBudgetCaps. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load")
+    bool bTrackServerLoad = true;
+
+    /** Seconds for the smoothed timings to cover ~63% of a change, so single hitches do not trip the budget. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load", meta = (EditCondition = "bTrackServerLoad"))
+    float LoadSmoothingTime = 2.0f;
+
+    /** Smoothed game thread milliseconds per frame above which the caps apply. 0 disables the check. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load", meta = (EditCondition = "bTrackServerLoad"))
+    float GameThreadBudgetMs = 30.0f;
+
+    /** Smoothed AI milliseconds per frame above which the caps apply. 0 disables the check. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load", meta = (EditCondition = "bTrackServerLoad"))
+    float AIBudgetMs = 4.0f;
+
+    /** The caps are lifted once both timings fall below this fraction of their budget. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bTrackServerLoad"))
+    float BudgetReleaseFraction = 0.8f;
+
+    /** Limits handed to UGameDirectorSubsystem::SetLoadCaps while over budget, whatever the director decides. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load", meta = (EditCondition = "bTrackServerLoad"))
+    FGameDirectorLoadCaps OverBudgetCaps;
+
+    /**
+     * Appends every scenario, model response and latency to Saved/GameDirector/Recordings/<World>-<time>.ndjson
+     * for replay through the benchmark commandlet. Also enabled by GameDirector.Record 1.
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector")
+    bool bRecordScenarios = false;
+
+    /** LoRA adapter to attach per game mode class name (e.g. BP_ShooterGameMode_C -> Shooter). Unmapped modes use the active adapter. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector")
+    TMap<FName, FName> GameModeAdapters;
+
     // --- Delegate ---
     UPROPERTY(BlueprintAssignable, Category = "GameDirector")
     FOnDirectorEvaluated OnDirectorEvaluated;
 
 private:
     void RefreshCachedDirector();
+    FName ResolveAdapterForWorld(const UWorld* World) const;
+
+    /** Returns the session recorder when recording is enabled, opening it on first use. */
+    TSharedPtr<FGameDirectorRecorder> GetRecorder();
 
     UWorld* GetWorldSafe() const;
 
+    /** Folds the last frame into the smoothed timings and switches the load caps on budget transitions. */
+    void UpdateServerLoad();
+
     float TimeSinceLastEval = 0.0f;
+    float DirtyScore = 0.0f;
+    float SmoothedGameThreadMs = 0.0f;
+    float SmoothedAIMs = 0.0f;
+    double FrameAISeconds = 0.0;
+    bool bOverBudget = false;
     TWeakObjectPtr<UGameDirectorSubsystem> CachedDirector;
+    TSharedPtr<FGameDirectorRecorder> Recorder;
 };
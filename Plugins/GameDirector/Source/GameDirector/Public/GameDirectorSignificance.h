@@ -0,0 +1,164 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "UObject/Interface.h"
+
+#include "GameDirectorSignificance.generated.h"
+
+/** How much of the player's attention an AI actor has, from most to least. */
+UENUM(BlueprintType)
+enum class EGameDirectorSignificance : uint8
+{
+    /** Near and in view. */
+    High,
+    Medium,
+    Low,
+    /** Far and out of view. */
+    Dormant
+};
+
+/** Per-bucket limits an AI actor applies to its own logic. */
+USTRUCT(BlueprintType)
+struct GAMEDIRECTOR_API FGameDirectorSignificanceBudget
+{
+    GENERATED_BODY()
+
+    FGameDirectorSignificanceBudget() = default;
+
+    FGameDirectorSignificanceBudget(float InDecisionIntervalScale, float InBrainTickInterval, int32 InMaxLineOfSightChecks, bool bInSightEnabled, bool bInTraceShots)
+        : DecisionIntervalScale(InDecisionIntervalScale)
+        , BrainTickInterval(InBrainTickInterval)
+        , MaxLineOfSightChecks(InMaxLineOfSightChecks)
+        , bSightEnabled(bInSightEnabled)
+        , bTraceShots(bInTraceShots)
+    {
+    }
+
+    /** Multiplier on scripted decision intervals such as AEnemyCharacter peek toggles. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|Significance", meta = (ClampMin = "1.0"))
+    float DecisionIntervalScale = 1.0f;
+
+    /** Seconds between ticks of the controller's brain component (StateTree or behavior tree); 0 ticks every frame. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|Significance", meta = (ClampMin = "0.0"))
+    float BrainTickInterval = 0.0f;
+
+    /** Cap on the vertical traces a line of sight check may run. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|Significance", meta = (ClampMin = "2"))
+    int32 MaxLineOfSightChecks = 5;
+
+    /** Whether the sight sense keeps updating. Hearing and damage senses are event driven and stay on. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|Significance")
+    bool bSightEnabled = true;
+
+    /** Whether simulated shots run a trace at all. */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "GameDirector|Significance")
+    bool bTraceShots = true;
+};
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UGameDirectorSignificant : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * Implemented by AI pawns registered with UGameDirectorSignificanceManager.
+ */
+class GAMEDIRECTOR_API IGameDirectorSignificant
+{
+    GENERATED_BODY()
+
+public:
+    /** Called on registration and whenever the actor moves to another bucket. */
+    virtual void OnSignificanceChanged(EGameDirectorSignificance Significance, const FGameDirectorSignificanceBudget& Budget) = 0;
+};
+
+/**
+ * Buckets registered AI actors by distance to, and visibility from, the nearest player view so their decision rate,
+ * trace counts and perception follow what the player can observe.
+ *
+ * Visibility is a view cone test combined with WasRecentlyRendered, so classification itself runs no traces.
+ * Actors out of view drop one bucket. All actors are reclassified every UpdateInterval and only bucket changes are
+ * forwarded.
+ */
+UCLASS(config = Game)
+class GAMEDIRECTOR_API UGameDirectorSignificanceManager : public UWorldSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    UGameDirectorSignificanceManager();
+
+    virtual void Deinitialize() override;
+
+    // --- Tickable interface ---
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override { return Actors.Num() > 0; }
+    virtual TStatId GetStatId() const override
+    {
+        RETURN_QUICK_DECLARE_CYCLE_STAT(UGameDirectorSignificanceManager, STATGROUP_Tickables);
+    }
+
+    /** Adds an actor implementing IGameDirectorSignificant and immediately reports its bucket. */
+    void RegisterActor(AActor* Actor);
+
+    void UnregisterActor(AActor* Actor);
+
+    const FGameDirectorSignificanceBudget& GetBudget(EGameDirectorSignificance Significance) const;
+
+    /** Returns the manager of the context object's world, or nullptr. */
+    static UGameDirectorSignificanceManager* Get(const UObject* WorldContextObject);
+
+    /** Seconds between reclassification passes. */
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance", meta = (ClampMin = "0.0"))
+    float UpdateInterval = 0.25f;
+
+    /** Upper distance bounds of the High, Medium and Low buckets in cm; anything further is Dormant. */
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    float HighDistance = 2000.0f;
+
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    float MediumDistance = 5000.0f;
+
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    float LowDistance = 10000.0f;
+
+    /** Half angle of the view cone counted as in view, in degrees; wider than the camera FOV to cover turning. */
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    float ViewConeHalfAngle = 70.0f;
+
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    FGameDirectorSignificanceBudget HighBudget;
+
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    FGameDirectorSignificanceBudget MediumBudget;
+
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    FGameDirectorSignificanceBudget LowBudget;
+
+    UPROPERTY(Config, EditAnywhere, Category = "GameDirector|Significance")
+    FGameDirectorSignificanceBudget DormantBudget;
+
+private:
+    struct FViewPoint
+    {
+        FVector Location;
+        FVector Direction;
+    };
+
+    void GatherViewPoints(TArray<FViewPoint>& OutViews) const;
+
+    EGameDirectorSignificance Classify(const AActor* Actor, TConstArrayView<FViewPoint> Views, bool bCheckRendered) const;
+
+    void Notify(int32 Index);
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<AActor>> Actors;
+
+    /** Parallel to Actors. */
+    TArray<EGameDirectorSignificance> Significance;
+
+    float TimeUntilUpdate = 0.0f;
+};
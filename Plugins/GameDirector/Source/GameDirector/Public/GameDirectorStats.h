@@ -0,0 +1,140 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StaticArray.h"
+#include "HAL/PlatformTime.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("GameDirector"), STATGROUP_GameDirector, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inference"), STAT_GameDirector_Inference, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tokenize"), STAT_GameDirector_Tokenize, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Prompt Decode"), STAT_GameDirector_PromptDecode, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Token Decode"), STAT_GameDirector_TokenDecode, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sample"), STAT_GameDirector_Sample, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse Response"), STAT_GameDirector_Parse, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Queue Tick"), STAT_GameDirector_QueueTick, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Policy"), STAT_GameDirector_Policy, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Decision Cache"), STAT_GameDirector_DecisionCache, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Difficulty Blend"), STAT_GameDirector_Blend, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Combat Schedule"), STAT_GameDirector_CombatSchedule, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Significance"), STAT_GameDirector_Significance, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Jobs"), STAT_GameDirector_PendingJobs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Jobs"), STAT_GameDirector_ActiveJobs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Completed Jobs"), STAT_GameDirector_CompletedJobs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Deferred Combat Events"), STAT_GameDirector_DeferredCombatEvents, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Queue Wait (ms)"), STAT_GameDirector_LastQueueWaitMs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Time To First Token (ms)"), STAT_GameDirector_LastTimeToFirstTokenMs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Last Inference (ms)"), STAT_GameDirector_LastInferenceMs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Prompt Tokens/s"), STAT_GameDirector_PromptTokensPerSecond, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Generated Tokens/s"), STAT_GameDirector_TokensPerSecond, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Smoothed Game Thread (ms)"), STAT_GameDirector_GameThreadMs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Smoothed AI (ms)"), STAT_GameDirector_AIMs, STATGROUP_GameDirector, GAMEDIRECTOR_API);
+
+/** Per-request timings reported by FLlamaRunner::RunInference. All durations are in milliseconds. */
+struct FGameDirectorInferenceStats
+{
+    double TokenizeMs = 0.0;
+    double PromptDecodeMs = 0.0;
+
+    /** Sum of the single-token decode calls during generation. */
+    double TokenDecodeMs = 0.0;
+
+    /** Sum of the time spent choosing tokens from the logits. */
+    double SampleMs = 0.0;
+
+    /** From the start of the request until the first generated token was sampled. */
+    double TimeToFirstTokenMs = 0.0;
+
+    double TotalMs = 0.0;
+
+    int32 PromptTokens = 0;
+    int32 GeneratedTokens = 0;
+
+    /** Throughput derived from llama_perf_context for this request. */
+    double PromptTokensPerSecond = 0.0;
+    double TokensPerSecond = 0.0;
+
+    double GetPerTokenDecodeMs() const { return GeneratedTokens > 0 ? TokenDecodeMs / GeneratedTokens : 0.0; }
+};
+
+class UGameDirectorService;
+
+/**
+ * Adds its own lifetime to the AI time of the context object's world (see UGameDirectorService::AddAITime), so each
+ * world's load tracking only sees its own AI. The combat scheduler, difficulty blender, significance manager and AI
+ * controllers wrap their ticks in one. Does nothing in worlds without a service. Game thread only.
+ */
+class GAMEDIRECTOR_API FGameDirectorAITimeScope
+{
+public:
+    explicit FGameDirectorAITimeScope(const UObject* WorldContextObject);
+    ~FGameDirectorAITimeScope();
+
+    UE_NONCOPYABLE(FGameDirectorAITimeScope);
+
+private:
+    UGameDirectorService* Service;
+    double StartSeconds;
+};
+
+/**
+ * Process-wide rolling window of GameDirector latencies. Thread-safe; percentiles are available through the
+ * GameDirector.Stats console command.
+ */
+class GAMEDIRECTOR_API FGameDirectorStats
+{
+public:
+    enum class EMetric : uint8
+    {
+        QueueWait,
+        Tokenize,
+        PromptDecode,
+        PerTokenDecode,
+        Sample,
+        Parse,
+        TimeToFirstToken,
+        Inference,
+        TokensPerSecond,
+        Count
+    };
+
+    static FGameDirectorStats& Get();
+
+    /** Records the timings of a finished job and updates the STAT_ counters. */
+    void RecordJob(double QueueWaitMs, const FGameDirectorInferenceStats& InferenceStats);
+
+    /** Records a single sample for one metric. */
+    void RecordSample(EMetric Metric, double Value);
+
+    /** Computes percentiles over the current window. Returns false when no samples have been recorded. */
+    bool GetPercentiles(EMetric Metric, double& OutP50, double& OutP95, double& OutP99, int32& OutNumSamples) const;
+
+    /** Writes a p50/p95/p99 table for every metric. */
+    void Dump(FOutputDevice& Ar) const;
+
+    void Reset();
+
+    static const TCHAR* GetMetricName(EMetric Metric);
+
+    /** Nearest-rank percentile (0..1) of an ascending array. Returns 0 for an empty array. */
+    static double PercentileOfSorted(const TArray<double>& Sorted, double Percentile);
+
+private:
+    static constexpr int32 kWindowSize = 256;
+
+    struct FWindow
+    {
+        TStaticArray<double, kWindowSize> Values;
+        int32 NextIndex = 0;
+        int32 NumValues = 0;
+    };
+
+    /** Caller must hold Mutex. */
+    void PushLocked(EMetric Metric, double Value);
+
+    mutable FCriticalSection Mutex;
+    TStaticArray<FWindow, static_cast<int32>(EMetric::Count)> Windows;
+};
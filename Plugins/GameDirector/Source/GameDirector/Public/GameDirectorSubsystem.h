@@ -1,15 +1,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameDirectorDecisionCache.h"
+#include "GameDirectorPolicy.h"
+#include "GameDirectorScenario.h"
 #include "GameDirectorTypes.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "TimerManager.h"
 
 #include "GameDirectorSubsystem.generated.h"
 
-class FLlamaRunner;
 class FJsonObject;
 class FGameDirectorJobQueue;
+class FGameDirectorModelManager;
+class ILlamaRunner;
+struct FGameDirectorModelBudget;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogGameDirector, Log, All);
 
@@ -18,7 +23,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnDifficultyChanged, const FAIDiffi
 /**
  * GameInstance subsystem that bridges gameplay telemetry with the local llama.cpp runner.
  */
-UCLASS()
+UCLASS(config = Game)
 class GAMEDIRECTOR_API UGameDirectorSubsystem : public UGameInstanceSubsystem
 {
     GENERATED_BODY()
@@ -29,23 +34,110 @@ public:
 
     /**
      * Submits a generic inference job and invokes the provided callback on completion (game thread).
+     * ModelId selects one of the models under Content/AIModels; NAME_None uses the default model.
+     * AdapterId selects a LoRA adapter for this request; NAME_None uses the active adapter.
      */
-    void RequestInference(FName ComponentId, const FString& ScenarioJSON, TFunction<void(const FString&)> OnResult);
+    void RequestInference(FName ComponentId, const FGameDirectorScenario& Scenario, TFunction<void(const FString&)> OnResult, FName ModelId = NAME_None, FName AdapterId = NAME_None);
 
     /**
-     * Convenience helper that performs a difficulty update request and applies the returned configuration.
+     * Overload for gda.fps.input.v1 JSON payloads; the scenario is parsed once here on the game thread. Only that schema
+     * is accepted: any other payload is rejected with an error and OnResult receives an empty string immediately.
+     */
+    void RequestInference(FName ComponentId, const FString& ScenarioJSON, TFunction<void(const FString&)> OnResult, FName ModelId = NAME_None, FName AdapterId = NAME_None);
+
+    /** Sets the LoRA adapter attached to requests that do not name one. NAME_None detaches adapters. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
+    void SetActiveAdapter(FName AdapterId);
+
+    /** Returns the LoRA adapter attached to requests that do not name one. */
+    FName GetActiveAdapter() const { return ActiveAdapterId; }
+
+    /** Starts loading a model in the background so the first request against it does not stall. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
+    void PrefetchModel(FName ModelId);
+
+    /**
+     * Convenience helper that performs a difficulty update request and applies the returned configuration. Scenario
+     * must be gda.fps.input.v1 JSON; anything else is logged as an error and ignored.
      */
     UFUNCTION(BlueprintCallable, Category = "GameDirector|AI")
     void RequestDifficultyUpdate(const FString& Scenario);
 
-    /** Broadcast whenever the model selects a new difficulty configuration. */
+    /**
+     * Tiered difficulty update. A close enough past LLM decision from the decision cache is reused first, then the
+     * distilled policy answers when it is confident; both run on the game thread. The LLM is queued when neither
+     * answered, when it has not been consulted for LLMConsultInterval, or when no policy is loaded. Without a model
+     * the policy is applied regardless of confidence. OnResult receives every gda.fps.output.v1 response that was
+     * applied: local decisions synchronously with bFromLLM cleared, LLM responses on completion with it set.
+     */
+    void RequestDifficultyDecision(const FGameDirectorScenario& Scenario, TFunction<void(const FString&, bool bFromLLM)> OnResult = nullptr, FName AdapterId = NAME_None);
+
+    /** Distilled policy used as the fast tier; invalid when no policy file was found. */
+    const FGameDirectorPolicy& GetPolicy() const { return Policy; }
+
+    /**
+     * Broadcast whenever the model selects a new difficulty configuration. Per-AI consumers should poll
+     * GetDifficultySnapshot instead so a change costs the same regardless of how many AI exist.
+     */
     UPROPERTY(BlueprintAssignable, Category = "GameDirector|AI")
     FOnDifficultyChanged OnDifficultyChanged;
 
+    /** Latest published global configuration and its version. */
+    UFUNCTION(BlueprintPure, Category = "GameDirector|AI")
+    const FAIDifficultySnapshot& GetDifficultySnapshot() const { return GetTargetSnapshot(GlobalDifficultyTarget); }
+
+    /** Version of the latest published global configuration; cheap to compare every frame. */
+    int32 GetDifficultyVersion() const { return GetDifficultySnapshot().Version; }
+
+    /** Handle of the "all" target that global updates publish to. */
+    static constexpr int32 GlobalDifficultyTarget = 0;
+
+    /**
+     * Returns the handle of a difficulty target selector, adding it to the table if needed. Selectors are "all",
+     * "archetype:<name>", "squad:<name>" or "region:<name>"; anything else returns INDEX_NONE.
+     */
+    int32 FindOrAddDifficultyTarget(FName Selector);
+
+    /** Returns the handle of an already registered selector, or INDEX_NONE. Model output only addresses these. */
+    int32 FindDifficultyTarget(FName Selector) const;
+
+    /**
+     * Snapshot published to a target. Versions share one counter across targets, so among the targets an AI belongs
+     * to, the highest version is the most recent decision. Version 0 means the target has no active override.
+     */
+    const FAIDifficultySnapshot& GetTargetSnapshot(int32 TargetHandle) const;
+
+    /** "archetype" + "boss" -> archetype:boss. */
+    static FName MakeDifficultyTargetSelector(const TCHAR* Kind, FName Name);
+
+    /** Latest enemy pacing selected by the director; spawners compare its Version against the one they applied. */
+    UFUNCTION(BlueprintPure, Category = "GameDirector|Spawning")
+    const FGameDirectorSpawnPacing& GetSpawnPacing() const { return SpawnPacing; }
+
+    /**
+     * Installs the limits enforced while the server is over budget (see UGameDirectorService). Published aggression is
+     * clamped immediately: the global and every active target snapshot are republished with the capped values, and the
+     * requested values return once the caps are lifted.
+     */
+    void SetLoadCaps(const FGameDirectorLoadCaps& Caps);
+
+    /** Limits currently enforced; bActive is false while the server is within budget. */
+    UFUNCTION(BlueprintPure, Category = "GameDirector|Load")
+    const FGameDirectorLoadCaps& GetLoadCaps() const { return LoadCaps; }
+
+    /** Incremented by every SetLoadCaps that changes the caps; consumers holding capped values compare it to re-cap. */
+    int32 GetLoadCapsVersion() const { return LoadCapsVersion; }
+
+    /**
+     * Difficulty limited by the current load caps. Published snapshots are already capped; anything applied from
+     * elsewhere (per-AI defaults, direct overrides) should go through this so it can't exceed them.
+     */
+    FAIDifficulty CapDifficulty(const FAIDifficulty& Difficulty) const;
+
     /** Returns the baseline configuration used when timers expire. */
     const FAIDifficulty& GetBaselineDifficulty() const { return BaselineDifficulty; }
 
-    /** Returns the latest configuration pushed to listeners. */
+    /** Returns the latest global configuration selected by the director, before load caps. */
     const FAIDifficulty& GetCurrentDifficulty() const { return CurrentDifficulty; }
 
     /** True if the subsystem currently has work in flight. */
@@ -55,19 +147,146 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI")
     int32 MaxConcurrentJobs = 2;
 
+    /**
+     * Game-thread time allowed per frame for running completion callbacks, in milliseconds. At least one
+     * completion is dispatched each frame; the rest carry over. 0 dispatches everything in the same frame.
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI")
+    float MaxDispatchMsPerFrame = 0.0f;
+
+    /** RAM budget shared by all resident models in megabytes; least recently used models are evicted beyond it. 0 disables the limit. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI")
+    int32 ModelMemoryBudgetMB = 4096;
+
+    /**
+     * Model used when a request does not name one. Either an exact file name (pins one variant) or a base
+     * name whose quantized variants are chosen by the budget below. Empty uses the first base model found.
+     */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI")
+    FName DefaultModelName;
+
+    /** Largest model variant this platform may load, in megabytes. 0 only caps by physical memory. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Quantization")
+    int32 MaxModelVariantMB = 0;
+
+    /** Physical memory kept for the game and OS when sizing model variants, in megabytes. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Quantization")
+    int32 ReservedPhysicalMemoryMB = 4096;
+
+    /** Target decode time per generated token; larger variants that would exceed it are skipped. 0 disables. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Quantization")
+    float MaxDecodeMsPerToken = 0.0f;
+
+    /** Sustained memory bandwidth of the target CPU, used to estimate decode time from model size. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Quantization")
+    float MemoryBandwidthGBps = 20.0f;
+
+    /** Returns the manager owning all resident models, if any model was found. */
+    TSharedPtr<FGameDirectorModelManager> GetModelManager() const { return ModelManager; }
+
+    /**
+     * Routes every request to the given runner instead of the model manager (e.g. a FMockLlamaRunner for load
+     * tests). Passing nullptr restores the model manager. Call while IsBusy() is false: the job queue is
+     * rebuilt and callbacks of jobs still in flight are dropped.
+     */
+    void SetRunnerOverride(const TSharedPtr<ILlamaRunner>& InRunner);
+
+    /** Consult the distilled policy before the LLM for difficulty updates. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Policy")
+    bool bUsePolicyTier = true;
+
+    /** Lowest policy confidence applied without asking the LLM. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Policy", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUsePolicyTier"))
+    float PolicyConfidenceThreshold = 0.8f;
+
+    /** The LLM is still consulted at least this often, in seconds, to refresh decisions and collect training labels. 0 disables. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Policy", meta = (EditCondition = "bUsePolicyTier"))
+    float LLMConsultInterval = 60.0f;
+
+    /** Policy written by the GameDirectorTrainPolicy commandlet, relative to the Content directory. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Policy", meta = (EditCondition = "bUsePolicyTier"))
+    FString PolicyFile = TEXT("AIModels/DifficultyPolicy.json");
+
+    /** Reuse the decision of a sufficiently similar recent scenario instead of asking the LLM again. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Cache")
+    bool bUseDecisionCache = true;
+
+    /** Number of past LLM decisions kept for nearest-neighbour lookup. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Cache", meta = (ClampMin = "0", EditCondition = "bUseDecisionCache"))
+    int32 DecisionCacheSize = 256;
+
+    /** Lowest cosine similarity between scenario embeddings for a cached decision to be reused. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Cache", meta = (ClampMin = "0.0", ClampMax = "1.0", EditCondition = "bUseDecisionCache"))
+    float DecisionCacheSimilarity = 0.995f;
+
+    /** Cached decisions older than this many seconds are ignored. 0 keeps them until evicted. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Cache", meta = (EditCondition = "bUseDecisionCache"))
+    float DecisionCacheMaxAgeS = 120.0f;
+
+    /** Serve requests from a FMockLlamaRunner instead of loading a model. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Mock")
+    bool bUseMockRunner = false;
+
+    /** Median latency of the mock runner in milliseconds (log-normal). */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Mock", meta = (EditCondition = "bUseMockRunner"))
+    float MockLatencyMs = 250.0f;
+
+    /** Spread of the mock latency in milliseconds; the 84th percentile lands at MockLatencyMs + MockLatencySpreadMs. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "GameDirector|AI|Mock", meta = (EditCondition = "bUseMockRunner"))
+    float MockLatencySpreadMs = 100.0f;
+
 private:
-    void HandleModelResponse(const FString& Response);
-    bool TryParseDifficulty(const TSharedPtr<FJsonObject>& RootObject, FAIDifficulty& OutDifficulty, FString& OutReason) const;
+    bool HandleModelResponse(const FString& Response);
+    void ApplyDifficulty(int32 TargetHandle, const FAIDifficulty& Difficulty, const FString& Intent, const FString& Reason);
+    bool HasModel() const { return ModelManager.IsValid() || RunnerOverride.IsValid(); }
+    bool TryParseDifficulty(const TSharedPtr<FJsonObject>& RootObject, TArray<TPair<int32, FAIDifficulty>>& OutDifficulties, FString& OutReason);
+    bool TryParseSpawnPacing(const TSharedPtr<FJsonObject>& RootObject, FGameDirectorSpawnPacing& OutPacing) const;
     void RestoreBaseline();
-    FString ResolveModelPath() const;
+    void RestoreTarget(int32 TargetHandle);
+    void PublishDifficulty();
+    FString GetModelsDirectory() const;
+    FName ResolveDefaultModelId();
+    FName ResolveModelId(FName RequestedModelId);
+    FGameDirectorModelBudget MakeModelBudget() const;
     bool PumpJobQueue(float DeltaTime);
+    void CreateJobQueue();
 
 private:
-    TSharedPtr<FLlamaRunner> LlamaRunner;
+    TSharedPtr<FGameDirectorModelManager> ModelManager;
+    FName DefaultModelId;
+
+    /** Variant chosen for each requested base name; selected once so later requests do not switch variants. */
+    TMap<FName, FName> ResolvedModelIds;
+    FGameDirectorModelBudget ModelBudget;
+    FName ActiveAdapterId;
+    TSharedPtr<ILlamaRunner> RunnerOverride;
     TSharedPtr<FGameDirectorJobQueue> JobQueue;
     FTSTicker::FDelegateHandle JobQueueTickerHandle;
 
     FAIDifficulty BaselineDifficulty;
     FAIDifficulty CurrentDifficulty;
     FTimerHandle RestoreTimerHandle;
+
+    /** One entry per selector; index 0 is the global "all" target. */
+    struct FDifficultyTarget
+    {
+        FName Selector;
+
+        /** Override as selected by the director; Snapshot holds it after load caps. */
+        FAIDifficulty Requested;
+        FAIDifficultySnapshot Snapshot;
+        FTimerHandle RestoreTimerHandle;
+    };
+
+    TArray<FDifficultyTarget> DifficultyTargets;
+    TMap<FName, int32> DifficultyTargetIndex;
+    int32 LastDifficultyVersion = 0;
+
+    FGameDirectorSpawnPacing SpawnPacing;
+    FGameDirectorLoadCaps LoadCaps;
+    int32 LoadCapsVersion = 0;
+
+    FGameDirectorPolicy Policy;
+    FGameDirectorDecisionCache DecisionCache;
+    double LastLLMConsultSeconds = -UE_BIG_NUMBER;
 };
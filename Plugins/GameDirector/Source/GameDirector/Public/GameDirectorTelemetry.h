@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Containers/StaticArray.h"
+
+#include "GameDirectorTelemetry.generated.h"
+
+/** Windowed combat statistics for one player, as reported to the director. */
+USTRUCT(BlueprintType)
+struct GAMEDIRECTOR_API FGameDirectorTelemetrySnapshot
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    float DamageTakenPerSecond = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    float DamageDealtPerSecond = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    int32 ShotsFired = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    int32 ShotsHit = 0;
+
+    /** ShotsHit / ShotsFired, or 0 when nothing was fired in the window. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    float HitRatio = 0.0f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    int32 Kills = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    int32 Deaths = 0;
+
+    /** Seconds since the last death, or -1 if the player has not died this session. */
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "GameDirector|Telemetry")
+    float TimeSinceLastDeath = -1.0f;
+};
+
+/**
+ * Sliding-window accumulator made of one-second buckets in a fixed ring. Each event touches the current bucket and
+ * the running totals; buckets leaving the window are subtracted from the totals as time advances, so both recording
+ * and reading are O(1) regardless of event rate.
+ */
+class GAMEDIRECTOR_API FGameDirectorTelemetryWindow
+{
+public:
+    static constexpr int32 NumBuckets = 30;
+    static constexpr double BucketSeconds = 1.0;
+    static constexpr int32 NumTimestamps = 16;
+
+    void AddDamageTaken(double Now, float Amount);
+    void AddDamageDealt(double Now, float Amount);
+    void AddShotFired(double Now);
+    void AddShotHit(double Now);
+    void AddKill(double Now);
+    void AddDeath(double Now);
+
+    FGameDirectorTelemetrySnapshot GetSnapshot(double Now);
+
+    /** Most recent kill or death times, newest first. */
+    int32 GetRecentKillTimes(TArray<double>& OutTimes) const { return CopyTimestamps(KillTimes, NumKillTimes, KillHead, OutTimes); }
+    int32 GetRecentDeathTimes(TArray<double>& OutTimes) const { return CopyTimestamps(DeathTimes, NumDeathTimes, DeathHead, OutTimes); }
+
+    void Reset();
+
+private:
+    struct FBucket
+    {
+        float DamageTaken = 0.0f;
+        float DamageDealt = 0.0f;
+        int32 ShotsFired = 0;
+        int32 ShotsHit = 0;
+        int32 Kills = 0;
+        int32 Deaths = 0;
+    };
+
+    /** Rotates the ring up to Now, expiring buckets that fell out of the window, and returns the current bucket. */
+    FBucket& Advance(double Now);
+
+    static void PushTimestamp(TStaticArray<double, NumTimestamps>& Times, int32& Count, int32& Head, double Now);
+    static int32 CopyTimestamps(const TStaticArray<double, NumTimestamps>& Times, int32 Count, int32 Head, TArray<double>& OutTimes);
+
+    TStaticArray<FBucket, NumBuckets> Buckets;
+    FBucket Totals;
+    int64 HeadBucket = INDEX_NONE;
+    double StartTime = 0.0;
+
+    TStaticArray<double, NumTimestamps> KillTimes;
+    TStaticArray<double, NumTimestamps> DeathTimes;
+    int32 NumKillTimes = 0;
+    int32 NumDeathTimes = 0;
+    int32 KillHead = 0;
+    int32 DeathHead = 0;
+};
+
+/**
+ * Collects combat telemetry for the player it is attached to. Weapons, projectiles and damage handlers report into it;
+ * UGameDirectorService reads the windowed snapshot when it builds a scenario. Attach it to the player controller so the
+ * window survives respawns; a component on the pawn would restart from zero after every death.
+ */
+UCLASS(ClassGroup = (GameDirector), meta = (BlueprintSpawnableComponent))
+class GAMEDIRECTOR_API UGameDirectorTelemetry : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+    UGameDirectorTelemetry();
+
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|Telemetry")
+    void RecordDamageTaken(float Amount);
+
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|Telemetry")
+    void RecordDamageDealt(float Amount);
+
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|Telemetry")
+    void RecordShotFired();
+
+    /** Counts one shot as hitting a character; call once per shot even if it damages several. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|Telemetry")
+    void RecordShotHit();
+
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|Telemetry")
+    void RecordKill();
+
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|Telemetry")
+    void RecordDeath();
+
+    /** Aggregates over the last FGameDirectorTelemetryWindow::NumBuckets seconds. */
+    UFUNCTION(BlueprintCallable, Category = "GameDirector|Telemetry")
+    FGameDirectorTelemetrySnapshot GetSnapshot();
+
+    const FGameDirectorTelemetryWindow& GetWindow() const { return Window; }
+
+    /** Returns the telemetry component on Actor or, for a pawn, on its controller. Returns nullptr if neither has one. */
+    static UGameDirectorTelemetry* Find(const AActor* Actor);
+
+private:
+    double GetNow() const;
+
+    FGameDirectorTelemetryWindow Window;
+};
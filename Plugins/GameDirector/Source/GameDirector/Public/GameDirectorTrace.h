@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Trace/Config.h"
+#include "Trace/Trace.h"
+
+#if !defined(GAMEDIRECTOR_TRACE_ENABLED)
+#define GAMEDIRECTOR_TRACE_ENABLED (UE_TRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+#if GAMEDIRECTOR_TRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(GameDirectorChannel, GAMEDIRECTOR_API);
+#endif
+
+/** Lifecycle points of a GameDirector job, emitted on GameDirectorChannel. */
+enum class EGameDirectorTracePhase : uint8
+{
+    Enqueue,
+    Start,
+    FirstToken,
+    Complete,
+    Dispatch,
+    DifficultyBroadcast
+};
+
+/**
+ * Emits GameDirector job events to Unreal Insights. Enable with -trace=default,GameDirector (or Trace.Enable GameDirector).
+ *
+ * Each phase is logged as a GameDirector.JobPhase event carrying the job ID, and every job also opens a timing region
+ * from enqueue to dispatch so its lifetime lines up against frames in the Timing view.
+ */
+struct GAMEDIRECTOR_API FGameDirectorTrace
+{
+    /** Returns a process-unique, non-zero job ID. */
+    static uint64 AllocateJobId();
+
+    static void OutputPhase(uint64 JobId, EGameDirectorTracePhase Phase, FName ComponentId = NAME_None);
+
+    /** Emits a phase for the job bound to the calling thread by FJobScope, if any. */
+    static void OutputCurrentJobPhase(EGameDirectorTracePhase Phase);
+
+    static void BeginJobRegion(uint64 JobId, FName ComponentId);
+    static void EndJobRegion(uint64 JobId, FName ComponentId);
+
+    static const TCHAR* GetPhaseName(EGameDirectorTracePhase Phase);
+
+    /** Binds a job ID to the calling thread so code without access to the job (runner, callbacks) can emit phases. */
+    struct GAMEDIRECTOR_API FJobScope
+    {
+        explicit FJobScope(uint64 JobId);
+        ~FJobScope();
+
+        FJobScope(const FJobScope&) = delete;
+        FJobScope& operator=(const FJobScope&) = delete;
+
+    private:
+        uint64 PreviousJobId;
+    };
+};
+
+#if GAMEDIRECTOR_TRACE_ENABLED
+#define TRACE_GAMEDIRECTOR_PHASE(JobId, Phase, ComponentId) FGameDirectorTrace::OutputPhase(JobId, EGameDirectorTracePhase::Phase, ComponentId)
+#define TRACE_GAMEDIRECTOR_CURRENT_PHASE(Phase) FGameDirectorTrace::OutputCurrentJobPhase(EGameDirectorTracePhase::Phase)
+#define TRACE_GAMEDIRECTOR_BEGIN_JOB(JobId, ComponentId) FGameDirectorTrace::BeginJobRegion(JobId, ComponentId)
+#define TRACE_GAMEDIRECTOR_END_JOB(JobId, ComponentId) FGameDirectorTrace::EndJobRegion(JobId, ComponentId)
+#define TRACE_GAMEDIRECTOR_JOB_SCOPE(JobId) FGameDirectorTrace::FJobScope PREPROCESSOR_JOIN(GameDirectorJobScope, __LINE__)(JobId)
+#else
+#define TRACE_GAMEDIRECTOR_PHASE(JobId, Phase, ComponentId)
+#define TRACE_GAMEDIRECTOR_CURRENT_PHASE(Phase)
+#define TRACE_GAMEDIRECTOR_BEGIN_JOB(JobId, ComponentId)
+#define TRACE_GAMEDIRECTOR_END_JOB(JobId, ComponentId)
+#define TRACE_GAMEDIRECTOR_JOB_SCOPE(JobId)
+#endif
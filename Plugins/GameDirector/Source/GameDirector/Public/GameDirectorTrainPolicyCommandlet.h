@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "GameDirectorTrainPolicyCommandlet.generated.h"
+
+/**
+ * Distills recorded LLM decisions into a FGameDirectorPolicy and reports how well it matches held-out decisions.
+ *
+ * Usage: -run=GameDirectorTrainPolicy [-Recordings=<file or dir>] [-Output=<file.json>] [-MaxDepth=N] [-MinLeaf=N]
+ *        [-Holdout=0.2] [-Seed=N] [-Threshold=0.8]
+ *
+ * Recordings are FGameDirectorRecorder logs, by default everything under Saved/GameDirector/Recordings; entries whose
+ * response is not a valid AdjustAIDifficulty call are skipped. The policy is written to Content/AIModels/
+ * DifficultyPolicy.json unless -Output is given. The report lists per-output holdout accuracy and, at -Threshold, the
+ * share of scenarios the policy would answer alone and how often those answers match the LLM.
+ */
+UCLASS()
+class GAMEDIRECTOR_API UGameDirectorTrainPolicyCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UGameDirectorTrainPolicyCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
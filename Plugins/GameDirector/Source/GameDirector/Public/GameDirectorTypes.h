@@ -4,6 +4,21 @@
 
 #include "GameDirectorTypes.generated.h"
 
+/**
+ * Gameplay events that make the current difficulty decision stale. Each adds weight to the
+ * UGameDirectorService dirty score; evaluation runs once the score crosses its threshold.
+ */
+UENUM(BlueprintType)
+enum class EGameDirectorEvent : uint8
+{
+    PlayerDeath,
+    /** Magnitude is the damage as a fraction of the player's max HP. */
+    PlayerDamaged,
+    EnemySpawned,
+    EnemyDied,
+    TeamScoreChanged
+};
+
 /**
  * Struct describing an AI difficulty configuration emitted by the llama policy.
  */
@@ -48,5 +63,103 @@ struct GAMEDIRECTOR_API FAIDifficulty
 
     /** Creates a human readable representation suitable for logging. */
     FString ToString() const;
+
+    /** gda.fps.output.v1 response carrying this configuration, for decisions made without the LLM. */
+    FString ToResponseJSON(const FString& Reason) const;
+
+    bool operator==(const FAIDifficulty& Other) const
+    {
+        return AimSpreadLevel == Other.AimSpreadLevel
+            && AimSpreadFine == Other.AimSpreadFine
+            && ReactionLevel == Other.ReactionLevel
+            && AggressionLevel == Other.AggressionLevel
+            && PeekLevel == Other.PeekLevel
+            && DurationS == Other.DurationS;
+    }
+
+    bool operator!=(const FAIDifficulty& Other) const { return !(*this == Other); }
 };
 
+/**
+ * Enemy population pacing selected by the SetSpawnPacing tool. A game-side spawner keeps the live enemy count at
+ * TargetEnemyCount, adding one enemy at most every SpawnIntervalS between MinSpawnDistance and MaxSpawnDistance of
+ * the player.
+ */
+USTRUCT(BlueprintType)
+struct GAMEDIRECTOR_API FGameDirectorSpawnPacing
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Spawning")
+    int32 TargetEnemyCount = 6;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Spawning")
+    float SpawnIntervalS = 5.0f;
+
+    /** Spawn distance band around the player, in cm. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Spawning")
+    float MinSpawnDistance = 1500.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Spawning")
+    float MaxSpawnDistance = 4000.0f;
+
+    /** Increases with every change; 0 until the director first selects a pacing. */
+    UPROPERTY(BlueprintReadOnly, Category = "GameDirector|Spawning")
+    int32 Version = 0;
+
+    FString ToString() const;
+};
+
+/**
+ * Hard limits UGameDirectorService imposes while the server is over its frame budget. The subsystem clamps the
+ * aggression it publishes, the difficulty blender clamps enemy fire rate and spawners keep the live enemy count at or
+ * below MaxEnemyCount, whatever the director decided.
+ */
+USTRUCT(BlueprintType)
+struct GAMEDIRECTOR_API FGameDirectorLoadCaps
+{
+    GENERATED_BODY()
+
+    /** False while the server is within budget; the limits below are ignored. */
+    UPROPERTY(BlueprintReadOnly, Category = "GameDirector|Load")
+    bool bActive = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load")
+    int32 MaxAggressionLevel = 2;
+
+    /** Shots per second. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load")
+    float MaxFireRate = 1.5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GameDirector|Load")
+    int32 MaxEnemyCount = 4;
+
+    bool operator==(const FGameDirectorLoadCaps& Other) const
+    {
+        return bActive == Other.bActive
+            && MaxAggressionLevel == Other.MaxAggressionLevel
+            && MaxFireRate == Other.MaxFireRate
+            && MaxEnemyCount == Other.MaxEnemyCount;
+    }
+
+    bool operator!=(const FGameDirectorLoadCaps& Other) const { return !(*this == Other); }
+
+    FString ToString() const;
+};
+
+/**
+ * Immutable difficulty state published by UGameDirectorSubsystem. Version increases with every change, so readers
+ * compare it against the version they last applied instead of subscribing to change notifications.
+ */
+USTRUCT(BlueprintType)
+struct GAMEDIRECTOR_API FAIDifficultySnapshot
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "GameDirector|Difficulty")
+    FAIDifficulty Difficulty;
+
+    /** 0 until the subsystem publishes its first configuration. */
+    UPROPERTY(BlueprintReadOnly, Category = "GameDirector|Difficulty")
+    int32 Version = 0;
+};
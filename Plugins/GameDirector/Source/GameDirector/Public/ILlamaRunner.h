@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameDirectorScenario.h"
+#include "GameDirectorStats.h"
+
+/**
+ * Inference backend used by FGameDirectorJobQueue. FLlamaRunner drives llama.cpp; FMockLlamaRunner returns canned
+ * responses so the scheduling path can be exercised without a model. Implementations must be callable from
+ * several worker threads at once.
+ */
+class GAMEDIRECTOR_API ILlamaRunner
+{
+public:
+    virtual ~ILlamaRunner() = default;
+
+    /**
+     * Executes a synchronous inference call for the scenario and returns the raw JSON string.
+     * AdapterId attaches a previously loaded LoRA adapter for this request; NAME_None runs the base model.
+     * When OutStats is provided it receives the per-stage timings of this request.
+     */
+    virtual FString RunInference(const FGameDirectorScenario& Scenario, FName AdapterId = NAME_None, FGameDirectorInferenceStats* OutStats = nullptr) = 0;
+
+    /** Returns true once the runner can serve requests. */
+    virtual bool IsLoaded() const = 0;
+
+    /** Returns true if the adapter can be attached on this runner. */
+    virtual bool HasAdapter(FName AdapterId) const = 0;
+
+    /** Memory held by the model weights in bytes, or 0 when nothing is loaded. */
+    virtual uint64 GetModelSizeBytes() const = 0;
+};
@@ -1,35 +1,87 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ILlamaRunner.h"
 #include <random>
 #include <numeric>
 #include <cmath>
 #include <cfloat>
 #include <llama.h>
+#include <vector>
 
 struct llama_model;
 struct llama_context;
+struct llama_adapter_lora;
 /**
  * Thin wrapper that manages llama.cpp lifecycle for the GameDirector plugin.
  */
-class GAMEDIRECTOR_API FLlamaRunner
+class GAMEDIRECTOR_API FLlamaRunner : public ILlamaRunner
 {
 public:
     FLlamaRunner();
-    ~FLlamaRunner();
+    virtual ~FLlamaRunner() override;
     llama_context_params ContextParams;
     /** Loads a GGUF model located on disk. */
     bool LoadModel(const FString& ModelPath);
 
-    /** Executes a synchronous inference call using the provided scenario prompt and returns the raw JSON string. */
-    FString RunInference(const FString& Prompt);
+    //~ Begin ILlamaRunner Interface
+    virtual FString RunInference(const FGameDirectorScenario& Scenario, FName AdapterId = NAME_None, FGameDirectorInferenceStats* OutStats = nullptr) override;
+    virtual bool IsLoaded() const override { return bIsLoaded; }
+    virtual bool HasAdapter(FName AdapterId) const override;
+
+    /** Total size of the loaded model tensors in bytes (llama_model_size), or 0 when nothing is loaded. */
+    virtual uint64 GetModelSizeBytes() const override;
+    //~ End ILlamaRunner Interface
+
+    /** Loads a LoRA adapter trained against the current base model. Adapters are dropped when the model is released. */
+    bool LoadAdapter(FName AdapterId, const FString& AdapterPath, float Scale = 1.0f);
+
+    /** Frees a previously loaded LoRA adapter. */
+    void UnloadAdapter(FName AdapterId);
+
+    /** Path of the currently loaded GGUF file. */
+    const FString& GetModelPath() const { return LoadedModelPath; }
+
+    /** True when the module was linked against llama.cpp; otherwise LoadModel always fails and only mocks can run. */
+    static constexpr bool IsAvailable() { return WITH_LLAMA != 0; }
+
+    /** llama_backend_init / llama_backend_free; no-ops when built without llama.cpp. */
+    static void InitializeBackend();
+    static void ShutdownBackend();
 private:
+    struct FLoadedAdapter
+    {
+        llama_adapter_lora* Adapter = nullptr;
+        float Scale = 1.0f;
+    };
+
     void Release();
 
+    /** Attaches the requested adapter to the context, detaching any other. Must be called with DecodeMutex held. */
+    bool ApplyAdapter(FName AdapterId);
+
+    /**
+     * Assembles the prompt for Scenario from cached token IDs, tokenizing only segments not seen before.
+     * Must be called with DecodeMutex held.
+     */
+    bool BuildPromptTokens(const llama_vocab* Vocab, const FGameDirectorScenario& Scenario, std::vector<llama_token>& OutTokens);
+
 private:
     FString LoadedModelPath;
     llama_model* Model;
     llama_context* Context;
     bool bIsLoaded;
+    TMap<FName, FLoadedAdapter> Adapters;
+    FName ActiveAdapterId;
     mutable FCriticalSection DecodeMutex;
+
+    /** Instructions and example before the scenario, and the output cue after it; tokenized once per model. */
+    std::vector<llama_token> PromptPrefixTokens;
+    std::vector<llama_token> PromptSuffixTokens;
+
+    /** Tokens of each " key=value" scenario segment, keyed by field and quantized value. */
+    TMap<uint32, std::vector<llama_token>> SegmentTokenCache;
+
+    /** True when the tokenizer inserts a leading space on its own (SentencePiece); segments then omit theirs. */
+    bool bTokenizerAddsSpacePrefix = false;
 };
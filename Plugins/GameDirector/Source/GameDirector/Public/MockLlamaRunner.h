@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ILlamaRunner.h"
+#include "Math/RandomStream.h"
+
+/** Shape of the simulated inference latency. */
+enum class EMockLatencyDistribution : uint8
+{
+    /** Always LatencyMs. */
+    Fixed,
+
+    /** Uniform in LatencyMs +/- LatencySpreadMs. */
+    Uniform,
+
+    /** Normal with mean LatencyMs and standard deviation LatencySpreadMs. */
+    Normal,
+
+    /** Log-normal with median LatencyMs and p84 at LatencyMs + LatencySpreadMs; has the long tail of real decode times. */
+    LogNormal
+};
+
+/** Behaviour of a FMockLlamaRunner. */
+struct FMockLlamaRunnerSettings
+{
+    EMockLatencyDistribution Distribution = EMockLatencyDistribution::Fixed;
+
+    /** Mean (Fixed/Uniform/Normal) or median (LogNormal) request latency in milliseconds. 0 returns immediately. */
+    float LatencyMs = 0.0f;
+
+    /** Spread of the distribution in milliseconds; see EMockLatencyDistribution. */
+    float LatencySpreadMs = 0.0f;
+
+    /** Share of the latency reported as time to first token. */
+    float TimeToFirstTokenFraction = 0.25f;
+
+    /** Token counts reported in the inference stats. */
+    int32 PromptTokens = 256;
+    int32 GeneratedTokens = 64;
+
+    /** Serialize requests like FLlamaRunner does on its single context, so lock contention shows up in load tests. */
+    bool bSerializeRequests = true;
+
+    /** Fraction of responses replaced with truncated JSON to exercise the error path. */
+    float InvalidResponseRate = 0.0f;
+
+    /** Responses returned in rotation. Empty uses a small built-in set of gda.fps.output.v1 responses. */
+    TArray<FString> Responses;
+
+    /** Seed for the latency and invalid-response draws, so runs are reproducible. */
+    int32 Seed = 0;
+};
+
+/**
+ * Deterministic stand-in for FLlamaRunner that returns canned gda.fps.output.v1 responses after a simulated latency.
+ * Thread-safe; used to load-test FGameDirectorJobQueue and UGameDirectorSubsystem without a model.
+ */
+class GAMEDIRECTOR_API FMockLlamaRunner : public ILlamaRunner
+{
+public:
+    explicit FMockLlamaRunner(const FMockLlamaRunnerSettings& InSettings = FMockLlamaRunnerSettings());
+
+    virtual FString RunInference(const FGameDirectorScenario& Scenario, FName AdapterId = NAME_None, FGameDirectorInferenceStats* OutStats = nullptr) override;
+    virtual bool IsLoaded() const override { return true; }
+    virtual bool HasAdapter(FName AdapterId) const override { return true; }
+    virtual uint64 GetModelSizeBytes() const override { return 0; }
+
+    /** Number of RunInference calls served so far. */
+    int64 GetRequestCount() const;
+
+private:
+    /** Draws the next latency and whether to corrupt the response. */
+    void DrawRequest(double& OutLatencyMs, bool& bOutInvalid, int32& OutResponseIndex);
+
+private:
+    FMockLlamaRunnerSettings Settings;
+
+    mutable FCriticalSection RandomMutex;
+    FRandomStream Random;
+    int64 RequestCount = 0;
+
+    /** Held for the simulated decode when bSerializeRequests is set. */
+    FCriticalSection DecodeMutex;
+};
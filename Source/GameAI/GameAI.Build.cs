@@ -15,10 +15,12 @@ public class GameAI : ModuleRules
 			"InputCore",
 			"EnhancedInput",
 			"AIModule",
+			"NavigationSystem",
 			"StateTreeModule",
 			"GameplayStateTreeModule",
 			"UMG",
-			"Slate"
+			"Slate",
+			"GameDirector"
 		});
 
 		PrivateDependencyModuleNames.AddRange(new string[] { });
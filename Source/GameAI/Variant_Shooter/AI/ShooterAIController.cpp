@@ -3,15 +3,18 @@
 
 #include "Variant_Shooter/AI/ShooterAIController.h"
 #include "ShooterNPC.h"
-#include "Components/StateTreeAIComponent.h"
+#include "ShooterStateTreeAIComponent.h"
 #include "Perception/AIPerceptionComponent.h"
+#include "Perception/AISense_Sight.h"
+#include "GameDirectorSignificance.h"
+#include "GameDirectorStats.h"
 #include "Navigation/PathFollowingComponent.h"
 #include "AI/Navigation/PathFollowingAgentInterface.h"
 
 AShooterAIController::AShooterAIController()
 {
 	// create the StateTree component
-	StateTreeAI = CreateDefaultSubobject<UStateTreeAIComponent>(TEXT("StateTreeAI"));
+	StateTreeAI = CreateDefaultSubobject<UShooterStateTreeAIComponent>(TEXT("StateTreeAI"));
 
 	// create the AI perception component. It will be configured in BP
 	AIPerception = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("AIPerception"));
@@ -28,11 +31,14 @@ void AShooterAIController::OnPossess(APawn* InPawn)
 	// ensure we're possessing an NPC
 	if (AShooterNPC* NPC = Cast<AShooterNPC>(InPawn))
 	{
-		// add the team tag to the pawn
-		NPC->Tags.Add(TeamTag);
+		// add the team tag to the pawn. Pooled pawns are possessed again on reuse
+		NPC->Tags.AddUnique(TeamTag);
 
 		// subscribe to the pawn's OnDeath delegate
 		NPC->OnPawnDeath.AddDynamic(this, &AShooterAIController::OnPawnDeath);
+
+		// the pawn may have been classified before we possessed it
+		ApplySignificanceBudget(NPC->GetSignificanceBudget());
 	}
 }
 
@@ -61,14 +67,32 @@ void AShooterAIController::ClearCurrentTarget()
 	TargetEnemy = nullptr;
 }
 
+void AShooterAIController::ApplySignificanceBudget(const FGameDirectorSignificanceBudget& Budget)
+{
+	// tick the StateTree less often when the player can't observe the result
+	StateTreeAI->SetComponentTickInterval(Budget.BrainTickInterval);
+
+	// sight is the only sense that traces every update; hearing and damage are event driven
+	const FAISenseID SightID = UAISense::GetSenseID<UAISense_Sight>();
+	if (AIPerception->GetSenseConfig(SightID))
+	{
+		AIPerception->SetSenseEnabled(UAISense_Sight::StaticClass(), Budget.bSightEnabled);
+	}
+}
+
 void AShooterAIController::OnPerceptionUpdated(AActor* Actor, FAIStimulus Stimulus)
 {
+	// the perception system's own traces tick world-wide; count the StateTree work this update triggers
+	FGameDirectorAITimeScope AITimeScope(this);
+
 	// pass the data to the StateTree delegate hook
 	OnShooterPerceptionUpdated.ExecuteIfBound(Actor, Stimulus);
 }
 
 void AShooterAIController::OnPerceptionForgotten(AActor* Actor)
 {
+	FGameDirectorAITimeScope AITimeScope(this);
+
 	// pass the data to the StateTree delegate hook
 	OnShooterPerceptionForgotten.ExecuteIfBound(Actor);
 }
@@ -6,9 +6,10 @@
 #include "AIController.h"
 #include "ShooterAIController.generated.h"
 
-class UStateTreeAIComponent;
+class UShooterStateTreeAIComponent;
 class UAIPerceptionComponent;
 struct FAIStimulus;
+struct FGameDirectorSignificanceBudget;
 
 DECLARE_DELEGATE_TwoParams(FShooterPerceptionUpdatedDelegate, AActor*, const FAIStimulus&);
 DECLARE_DELEGATE_OneParam(FShooterPerceptionForgottenDelegate, AActor*);
@@ -23,7 +24,7 @@ class GAMEAI_API AShooterAIController : public AAIController
 	
 	/** Runs the behavior StateTree for this NPC */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
-	UStateTreeAIComponent* StateTreeAI;
+	UShooterStateTreeAIComponent* StateTreeAI;
 
 	/** Detects other actors through sight, hearing and other senses */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
@@ -73,6 +74,9 @@ public:
 	/** Returns the targeted enemy */
 	AActor* GetCurrentTarget() const { return TargetEnemy; };
 
+	/** Scales the StateTree tick rate and sight updates to the pawn's significance */
+	void ApplySignificanceBudget(const FGameDirectorSignificanceBudget& Budget);
+
 protected:
 
 	/** Called when the AI perception component updates a perception on a given actor */
@@ -8,6 +8,12 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Engine/World.h"
 #include "ShooterGameMode.h"
+#include "ShooterAIController.h"
+#include "GameDirectorEnemyRegistry.h"
+#include "GameDirectorService.h"
+#include "GameDirectorTelemetry.h"
+#include "GameDirectorStats.h"
+#include "GameFramework/Controller.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TimerManager.h"
@@ -23,6 +29,23 @@ void AShooterNPC::BeginPlay()
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
 	Weapon = GetWorld()->SpawnActor<AShooterWeapon>(WeaponClass, GetActorTransform(), SpawnParams);
+
+	// save the state that death changes so pooled NPCs can be restored
+	StartingHP = CurrentHP;
+	MeshRelativeTransform = GetMesh()->GetRelativeTransform();
+	MeshCollisionProfile = GetMesh()->GetCollisionProfileName();
+
+	// pooled NPCs start parked and only join the game when activated
+	if (bPooled)
+	{
+		DeactivateForPool();
+		return;
+	}
+
+	// notify the game director
+	UGameDirectorService::ReportEvent(this, EGameDirectorEvent::EnemySpawned);
+
+	RegisterWithDirector();
 }
 
 void AShooterNPC::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -31,6 +54,15 @@ void AShooterNPC::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 	// clear the death timer
 	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	UnregisterFromDirector();
+}
+
+void AShooterNPC::Tick(float DeltaTime)
+{
+	FGameDirectorAITimeScope AITimeScope(this);
+
+	Super::Tick(DeltaTime);
 }
 
 float AShooterNPC::TakeDamage(float Damage, struct FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
@@ -47,6 +79,12 @@ float AShooterNPC::TakeDamage(float Damage, struct FDamageEvent const& DamageEve
 	// Have we depleted HP?
 	if (CurrentHP <= 0.0f)
 	{
+		// credit the kill to the instigator's game director telemetry
+		if (UGameDirectorTelemetry* Telemetry = UGameDirectorTelemetry::Find(EventInstigator))
+		{
+			Telemetry->RecordKill();
+		}
+
 		Die();
 	}
 
@@ -148,6 +186,18 @@ void AShooterNPC::OnSemiWeaponRefire()
 	}
 }
 
+void AShooterNPC::OnSignificanceChanged(EGameDirectorSignificance Significance, const FGameDirectorSignificanceBudget& Budget)
+{
+	// save the budget so StateTree conditions can read it
+	SignificanceBudget = Budget;
+
+	// throttle the controller's brain and perception
+	if (AShooterAIController* AIController = Cast<AShooterAIController>(GetController()))
+	{
+		AIController->ApplySignificanceBudget(Budget);
+	}
+}
+
 void AShooterNPC::Die()
 {
 	// ignore if already dead
@@ -165,6 +215,10 @@ void AShooterNPC::Die()
 		GM->IncrementTeamScore(TeamByte);
 	}
 
+	// notify the game director
+	UGameDirectorService::ReportEvent(this, EGameDirectorEvent::EnemyDied);
+	UnregisterFromDirector();
+
 	// disable capsule collision
 	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
@@ -183,9 +237,119 @@ void AShooterNPC::Die()
 
 void AShooterNPC::DeferredDestruction()
 {
+	// pooled NPCs go back to their spawner
+	if (bPooled)
+	{
+		DeactivateForPool();
+		return;
+	}
+
 	Destroy();
 }
 
+void AShooterNPC::DeactivateForPool()
+{
+	bPooled = true;
+	bDormant = true;
+
+	GetWorld()->GetTimerManager().ClearTimer(DeathTimer);
+
+	// stop firing and release the controller. Activation spawns a fresh one
+	if (bIsShooting && Weapon)
+	{
+		StopShooting();
+	}
+
+	if (AController* OwningController = GetController())
+	{
+		OwningController->UnPossess();
+		OwningController->Destroy();
+	}
+
+	UnregisterFromDirector();
+
+	// take the NPC out of the world
+	GetCharacterMovement()->StopMovementImmediately();
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+
+	if (Weapon)
+	{
+		Weapon->SetActorHiddenInGame(true);
+	}
+}
+
+void AShooterNPC::ActivateFromPool(const FTransform& SpawnTransform)
+{
+	if (!bDormant)
+	{
+		return;
+	}
+
+	bDormant = false;
+	bIsDead = false;
+	CurrentHP = StartingHP;
+	CurrentAimTarget = nullptr;
+
+	// undo the ragdoll
+	GetMesh()->SetSimulatePhysics(false);
+	GetMesh()->SetPhysicsBlendWeight(0.0f);
+	GetMesh()->SetCollisionProfileName(MeshCollisionProfile);
+	GetMesh()->AttachToComponent(GetCapsuleComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	GetMesh()->SetRelativeTransform(MeshRelativeTransform);
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+
+	// bring the NPC back into the world
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
+	if (Weapon)
+	{
+		// a reused NPC starts with a full magazine, like a freshly spawned one
+		Weapon->RefillMagazine();
+		Weapon->SetActorHiddenInGame(false);
+	}
+
+	// the new controller restarts the StateTree
+	SpawnDefaultController();
+
+	// notify the game director
+	UGameDirectorService::ReportEvent(this, EGameDirectorEvent::EnemySpawned);
+
+	RegisterWithDirector();
+}
+
+void AShooterNPC::RegisterWithDirector()
+{
+	// count this NPC in the director's scenario
+	if (UGameDirectorEnemyRegistry* Registry = UGameDirectorEnemyRegistry::Get(this))
+	{
+		Registry->RegisterEnemy(this);
+	}
+
+	// scale AI work with how observable this NPC is
+	if (UGameDirectorSignificanceManager* Significance = UGameDirectorSignificanceManager::Get(this))
+	{
+		Significance->RegisterActor(this);
+	}
+}
+
+void AShooterNPC::UnregisterFromDirector()
+{
+	if (UGameDirectorEnemyRegistry* Registry = UGameDirectorEnemyRegistry::Get(this))
+	{
+		Registry->UnregisterEnemy(this);
+	}
+
+	if (UGameDirectorSignificanceManager* Significance = UGameDirectorSignificanceManager::Get(this))
+	{
+		Significance->UnregisterActor(this);
+	}
+}
+
 void AShooterNPC::StartShooting(AActor* ActorToShoot)
 {
 	// save the aim target
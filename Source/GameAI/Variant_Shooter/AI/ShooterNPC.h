@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameAICharacter.h"
 #include "ShooterWeaponHolder.h"
+#include "GameDirectorSignificance.h"
 #include "ShooterNPC.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FPawnDeathDelegate);
@@ -17,7 +18,7 @@ class AShooterWeapon;
  *  Holds and manages a weapon
  */
 UCLASS(abstract)
-class GAMEAI_API AShooterNPC : public AGameAICharacter, public IShooterWeaponHolder
+class GAMEAI_API AShooterNPC : public AGameAICharacter, public IShooterWeaponHolder, public IGameDirectorSignificant
 {
 	GENERATED_BODY()
 
@@ -81,9 +82,25 @@ protected:
 	/** If true, this character has already died */
 	bool bIsDead = false;
 
+	/** If true, this NPC is owned by a spawner pool and is parked instead of destroyed after death */
+	bool bPooled = false;
+
+	/** If true, this pooled NPC is parked out of play waiting to be activated */
+	bool bDormant = false;
+
+	/** HP restored when a pooled NPC is activated */
+	float StartingHP = 100.0f;
+
+	/** Mesh placement and collision saved before ragdolling so pooled NPCs can be restored */
+	FTransform MeshRelativeTransform;
+	FName MeshCollisionProfile;
+
 	/** Deferred destruction on death timer */
 	FTimerHandle DeathTimer;
 
+	/** AI limits for this NPC's current significance bucket */
+	FGameDirectorSignificanceBudget SignificanceBudget;
+
 public:
 
 	/** Delegate called when this NPC dies */
@@ -97,6 +114,9 @@ protected:
 	/** Gameplay cleanup */
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Counts the tick towards the GameDirector's AI time */
+	virtual void Tick(float DeltaTime) override;
+
 public:
 
 	/** Handle incoming damage */
@@ -135,6 +155,18 @@ public:
 
 	//~End IShooterWeaponHolder interface
 
+public:
+
+	//~Begin IGameDirectorSignificant interface
+
+	/** Applies the AI limits of the new significance bucket to this NPC and its controller */
+	virtual void OnSignificanceChanged(EGameDirectorSignificance Significance, const FGameDirectorSignificanceBudget& Budget) override;
+
+	//~End IGameDirectorSignificant interface
+
+	/** Returns the AI limits for this NPC's current significance bucket */
+	const FGameDirectorSignificanceBudget& GetSignificanceBudget() const { return SignificanceBudget; }
+
 protected:
 
 	/** Called when HP is depleted and the character should die */
@@ -150,4 +182,29 @@ public:
 
 	/** Signals this character to stop shooting */
 	void StopShooting();
+
+public:
+
+	/** Marks this NPC as owned by a spawner pool. Must be called before it finishes spawning */
+	void SetPooled() { bPooled = true; }
+
+	/** Parks a pooled NPC out of play: hidden, without collision, controller or director registration */
+	void DeactivateForPool();
+
+	/** Brings a parked NPC back into play at the passed transform with full HP and a new controller */
+	void ActivateFromPool(const FTransform& SpawnTransform);
+
+	/** Returns true if this pooled NPC is currently parked */
+	bool IsDormant() const { return bDormant; }
+
+	/** Returns true if this character has died */
+	bool IsDead() const { return bIsDead; }
+
+protected:
+
+	/** Adds this NPC to the director's enemy registry and significance manager */
+	void RegisterWithDirector();
+
+	/** Removes this NPC from the director's enemy registry and significance manager */
+	void UnregisterFromDirector();
 };
@@ -0,0 +1,247 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Variant_Shooter/AI/ShooterNPCSpawner.h"
+#include "ShooterNPC.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/PlayerController.h"
+#include "GameDirectorSubsystem.h"
+#include "NavigationSystem.h"
+#include "GameAI.h"
+
+bool UShooterNPCSpawner::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UShooterNPCSpawner::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (NPCClass.IsNull() && InWorld.GetNetMode() != NM_Client)
+	{
+		UE_LOG(LogGameAI, Warning, TEXT("ShooterNPCSpawner: NPCClass is not set, so director spawn pacing is disabled. Set it under [/Script/GameAI.ShooterNPCSpawner] in DefaultGame.ini."));
+	}
+}
+
+void UShooterNPCSpawner::Deinitialize()
+{
+	Pool.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UShooterNPCSpawner::IsTickable() const
+{
+	// only the server paces NPCs
+	const UWorld* World = GetWorld();
+	return World && World->HasBegunPlay() && World->GetNetMode() != NM_Client && !NPCClass.IsNull();
+}
+
+void UShooterNPCSpawner::Tick(float DeltaTime)
+{
+	if (!bPrewarmed)
+	{
+		PrewarmPool();
+	}
+
+	SyncPacing();
+
+	// pace relative to the first local player
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APawn* PlayerPawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+	if (!PlayerPawn)
+	{
+		return;
+	}
+
+	TimeUntilSpawn -= DeltaTime;
+	if (TimeUntilSpawn > 0.0f)
+	{
+		return;
+	}
+
+	const int32 NumLive = GetNumLiveNPCs();
+	const int32 Target = FMath::Min3(Pacing.TargetEnemyCount, Pool.Num(), MaxLiveNPCs);
+
+	bool bChanged = false;
+	if (NumLive < Target)
+	{
+		bChanged = SpawnOne(*PlayerPawn);
+	}
+	else if (NumLive > Target)
+	{
+		bChanged = RetireOne(*PlayerPawn);
+	}
+
+	// retry next frame if nothing could be placed or parked
+	TimeUntilSpawn = bChanged ? Pacing.SpawnIntervalS : 0.0f;
+}
+
+int32 UShooterNPCSpawner::GetNumLiveNPCs() const
+{
+	int32 NumLive = 0;
+	for (const AShooterNPC* NPC : Pool)
+	{
+		NumLive += (IsValid(NPC) && !NPC->IsDormant() && !NPC->IsDead()) ? 1 : 0;
+	}
+
+	return NumLive;
+}
+
+void UShooterNPCSpawner::PrewarmPool()
+{
+	// load the class and pick up the default pacing on the first call
+	if (NumPrewarmAttempts == 0)
+	{
+		Pacing = DefaultPacing;
+		LoadedNPCClass = NPCClass.LoadSynchronous();
+		Pool.Reserve(PoolSize);
+
+		if (!LoadedNPCClass)
+		{
+			UE_LOG(LogGameAI, Error, TEXT("ShooterNPCSpawner: could not load NPCClass %s."), *NPCClass.ToString());
+			bPrewarmed = true;
+			return;
+		}
+	}
+
+	// park the pool at the origin. Parked NPCs are hidden and don't collide
+	const FTransform ParkTransform = FTransform::Identity;
+
+	// spawn a few per frame. Pacing already works with the NPCs parked so far
+	const int32 EndAttempt = FMath::Min(PoolSize, NumPrewarmAttempts + PrewarmSpawnsPerFrame);
+	for (; NumPrewarmAttempts < EndAttempt; ++NumPrewarmAttempts)
+	{
+		AShooterNPC* NPC = GetWorld()->SpawnActorDeferred<AShooterNPC>(LoadedNPCClass, ParkTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+		if (!NPC)
+		{
+			continue;
+		}
+
+		NPC->SetPooled();
+		NPC->FinishSpawning(ParkTransform);
+		Pool.Add(NPC);
+	}
+
+	bPrewarmed = NumPrewarmAttempts >= PoolSize;
+}
+
+void UShooterNPCSpawner::SyncPacing()
+{
+	const UGameInstance* GameInstance = GetWorld()->GetGameInstance();
+	const UGameDirectorSubsystem* Director = GameInstance ? GameInstance->GetSubsystem<UGameDirectorSubsystem>() : nullptr;
+	if (!Director)
+	{
+		return;
+	}
+
+	// the load cap applies even when the director's pacing is ignored
+	const FGameDirectorLoadCaps& LoadCaps = Director->GetLoadCaps();
+	MaxLiveNPCs = LoadCaps.bActive ? FMath::Max(0, LoadCaps.MaxEnemyCount) : MAX_int32;
+
+	if (!bFollowDirectorPacing)
+	{
+		return;
+	}
+
+	// version 0 means the director hasn't chosen a pacing yet
+	const FGameDirectorSpawnPacing& DirectorPacing = Director->GetSpawnPacing();
+	if (DirectorPacing.Version > 0 && DirectorPacing.Version != Pacing.Version)
+	{
+		Pacing = DirectorPacing;
+
+		// apply a shorter interval right away instead of waiting out the old one
+		TimeUntilSpawn = FMath::Min(TimeUntilSpawn, Pacing.SpawnIntervalS);
+	}
+}
+
+bool UShooterNPCSpawner::SpawnOne(const APawn& PlayerPawn)
+{
+	AShooterNPC* const* Parked = Pool.FindByPredicate([](const AShooterNPC* NPC) { return IsValid(NPC) && NPC->IsDormant(); });
+	if (!Parked)
+	{
+		return false;
+	}
+
+	FVector Location;
+	if (!FindSpawnLocation(PlayerPawn, Location))
+	{
+		return false;
+	}
+
+	// lift the capsule off the navmesh and face the player
+	Location.Z += (*Parked)->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	const FRotator Rotation((PlayerPawn.GetActorLocation() - Location).GetSafeNormal2D().Rotation());
+
+	(*Parked)->ActivateFromPool(FTransform(Rotation, Location));
+	return true;
+}
+
+bool UShooterNPCSpawner::RetireOne(const APawn& PlayerPawn)
+{
+	AShooterNPC* Farthest = nullptr;
+	float FarthestDistSq = -1.0f;
+
+	for (AShooterNPC* NPC : Pool)
+	{
+		// never pop an NPC out of view of the player
+		if (!IsValid(NPC) || NPC->IsDormant() || NPC->IsDead() || NPC->WasRecentlyRendered(RetireUnseenTime))
+		{
+			continue;
+		}
+
+		const float DistSq = FVector::DistSquared(NPC->GetActorLocation(), PlayerPawn.GetActorLocation());
+		if (DistSq > FarthestDistSq)
+		{
+			Farthest = NPC;
+			FarthestDistSq = DistSq;
+		}
+	}
+
+	if (!Farthest)
+	{
+		return false;
+	}
+
+	Farthest->DeactivateForPool();
+	return true;
+}
+
+bool UShooterNPCSpawner::FindSpawnLocation(const APawn& PlayerPawn, FVector& OutLocation) const
+{
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys)
+	{
+		return false;
+	}
+
+	const FVector Origin = PlayerPawn.GetActorLocation();
+	const FVector Facing = PlayerPawn.GetActorForwardVector().GetSafeNormal2D();
+
+	// try a few points in the distance band behind the player, falling back to any direction on the last attempt
+	constexpr int32 MaxAttempts = 4;
+	for (int32 Attempt = 0; Attempt < MaxAttempts; ++Attempt)
+	{
+		const float Distance = FMath::FRandRange(Pacing.MinSpawnDistance, Pacing.MaxSpawnDistance);
+		FVector Direction = FVector(FMath::RandPointInCircle(1.0f), 0.0f).GetSafeNormal();
+
+		// mirror directions in front of the player to behind them instead of wasting the attempt
+		const float FacingDot = FVector::DotProduct(Direction, Facing);
+		if (Attempt < MaxAttempts - 1 && FacingDot > 0.0f)
+		{
+			Direction -= 2.0f * FacingDot * Facing;
+		}
+
+		FNavLocation NavLocation;
+		if (NavSys->ProjectPointToNavigation(Origin + Direction * Distance, NavLocation))
+		{
+			OutLocation = NavLocation.Location;
+			return true;
+		}
+	}
+
+	return false;
+}
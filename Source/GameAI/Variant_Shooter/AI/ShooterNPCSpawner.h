@@ -0,0 +1,118 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "GameDirectorTypes.h"
+#include "ShooterNPCSpawner.generated.h"
+
+class AShooterNPC;
+
+/**
+ *  Keeps a pre-warmed pool of shooter NPCs and paces how many of them are alive
+ *  Follows the SetSpawnPacing decisions of the GameDirector: activates parked NPCs up to the target count,
+ *  one per spawn interval, and parks unseen NPCs when the target drops
+ *  The director's load caps limit the live count while the server is over budget
+ *  NPCs are never spawned or destroyed during play, so pacing changes don't hitch
+ */
+UCLASS(config=Game)
+class GAMEAI_API UShooterNPCSpawner : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	/** NPC class to pool. Spawning is disabled while unset, with a warning when play starts */
+	UPROPERTY(Config, EditAnywhere, Category="Spawning")
+	TSoftClassPtr<AShooterNPC> NPCClass;
+
+	/** Number of NPCs spawned when play starts. Also caps the live NPC count */
+	UPROPERTY(Config, EditAnywhere, Category="Spawning", meta = (ClampMin = 0, ClampMax = 64))
+	int32 PoolSize = 12;
+
+	/** Pool NPCs spawned per frame while prewarming, so filling the pool doesn't hitch the first frame */
+	UPROPERTY(Config, EditAnywhere, Category="Spawning", meta = (ClampMin = 1))
+	int32 PrewarmSpawnsPerFrame = 2;
+
+	/** If true, the GameDirector's spawn pacing replaces DefaultPacing once it's published */
+	UPROPERTY(Config, EditAnywhere, Category="Spawning")
+	bool bFollowDirectorPacing = true;
+
+	/** Pacing used until the director publishes one */
+	UPROPERTY(Config, EditAnywhere, Category="Spawning")
+	FGameDirectorSpawnPacing DefaultPacing;
+
+	/** NPCs seen by the player within this many seconds aren't parked when the target count drops */
+	UPROPERTY(Config, EditAnywhere, Category="Spawning", meta = (ClampMin = 0, Units = "s"))
+	float RetireUnseenTime = 2.0f;
+
+public:
+
+	/** Only pace NPCs in game worlds */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** Warns if pacing is disabled because no NPC class is configured */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/** Cleanup */
+	virtual void Deinitialize() override;
+
+	//~Begin FTickableGameObject interface
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(UShooterNPCSpawner, STATGROUP_Tickables);
+	}
+	//~End FTickableGameObject interface
+
+	/** Returns the number of pooled NPCs currently in play and alive */
+	int32 GetNumLiveNPCs() const;
+
+	/** Returns the pacing currently applied */
+	const FGameDirectorSpawnPacing& GetPacing() const { return Pacing; }
+
+protected:
+
+	/** Spawns the next few pool NPCs and parks them. Sets bPrewarmed once the pool is full */
+	void PrewarmPool();
+
+	/** Picks up a newer pacing and the current load cap from the GameDirector, if any */
+	void SyncPacing();
+
+	/** Activates one parked NPC around the player. Returns false if none could be placed */
+	bool SpawnOne(const APawn& PlayerPawn);
+
+	/** Parks the farthest live NPC the player hasn't seen recently. Returns false if none qualified */
+	bool RetireOne(const APawn& PlayerPawn);
+
+	/** Finds a navigable spawn location in the pacing's distance band around the player */
+	bool FindSpawnLocation(const APawn& PlayerPawn, FVector& OutLocation) const;
+
+protected:
+
+	/** All pooled NPCs, live or parked */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AShooterNPC>> Pool;
+
+	/** Pacing currently applied */
+	FGameDirectorSpawnPacing Pacing;
+
+	/** Live NPC limit imposed by the GameDirector while the server is over budget */
+	int32 MaxLiveNPCs = MAX_int32;
+
+	/** Time left until the next NPC may be activated or parked */
+	float TimeUntilSpawn = 0.0f;
+
+	/** NPC class loaded for the pool */
+	UPROPERTY(Transient)
+	TSubclassOf<AShooterNPC> LoadedNPCClass;
+
+	/** Number of pool spawns attempted so far, including failed ones */
+	int32 NumPrewarmAttempts = 0;
+
+	/** If true, the pool has been spawned */
+	bool bPrewarmed = false;
+};
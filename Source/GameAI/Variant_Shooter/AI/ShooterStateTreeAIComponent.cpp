@@ -0,0 +1,12 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+
+#include "Variant_Shooter/AI/ShooterStateTreeAIComponent.h"
+#include "GameDirectorStats.h"
+
+void UShooterStateTreeAIComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	FGameDirectorAITimeScope AITimeScope(this);
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StateTreeAIComponent.h"
+#include "ShooterStateTreeAIComponent.generated.h"
+
+/**
+ *  StateTree AI component for shooter NPCs
+ *  Counts its ticks, including the tasks and conditions they run, towards the GameDirector's AI time
+ */
+UCLASS(ClassGroup = AI, meta = (BlueprintSpawnableComponent))
+class GAMEAI_API UShooterStateTreeAIComponent : public UStateTreeAIComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Ticks the StateTree inside an AI time scope */
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+};
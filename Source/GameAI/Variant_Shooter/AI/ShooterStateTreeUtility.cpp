@@ -36,8 +36,12 @@ bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionCo
 	FVector CenterOfMass, Extent;
 	InstanceData.Target->GetActorBounds(true, CenterOfMass, Extent, false);
 
+	// cap the number of checks by the character's significance budget. The loop below runs NumberOfChecks - 1 traces,
+	// so keep at least 2 or a low budget (or a misconfigured task) would skip the check and report no line of sight
+	const int32 NumberOfChecks = FMath::Max(2, FMath::Min(InstanceData.NumberOfVerticalLineOfSightChecks, InstanceData.Character->GetSignificanceBudget().MaxLineOfSightChecks));
+
 	// divide the vertical extent by the number of line of sight checks we'll do
-	const float ExtentZOffset = Extent.Z * 2.0f / InstanceData.NumberOfVerticalLineOfSightChecks;
+	const float ExtentZOffset = Extent.Z * 2.0f / NumberOfChecks;
 
 	// get the character's camera location as the source for the line checks
 	const FVector Start = InstanceData.Character->GetFirstPersonCameraComponent()->GetComponentLocation();
@@ -50,7 +54,7 @@ bool FStateTreeLineOfSightToTargetCondition::TestCondition(FStateTreeExecutionCo
 	FHitResult OutHit;
 
 	// run a number of vertically offset line traces to the target location
-	for (int32 i = 0; i < InstanceData.NumberOfVerticalLineOfSightChecks - 1; ++i)
+	for (int32 i = 0; i < NumberOfChecks - 1; ++i)
 	{
 		// calculate the endpoint for the trace
 		const FVector End = CenterOfMass + FVector(0.0f, 0.0f, Extent.Z - ExtentZOffset * i);
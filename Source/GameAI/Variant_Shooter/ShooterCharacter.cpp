@@ -12,6 +12,8 @@
 #include "Camera/CameraComponent.h"
 #include "TimerManager.h"
 #include "ShooterGameMode.h"
+#include "GameDirectorService.h"
+#include "GameDirectorTelemetry.h"
 
 AShooterCharacter::AShooterCharacter()
 {
@@ -70,6 +72,15 @@ float AShooterCharacter::TakeDamage(float Damage, struct FDamageEvent const& Dam
 	// Reduce HP
 	CurrentHP -= Damage;
 
+	// record the damage on the controller's telemetry so it outlives this pawn
+	if (UGameDirectorTelemetry* Telemetry = UGameDirectorTelemetry::Find(GetController()))
+	{
+		Telemetry->RecordDamageTaken(Damage);
+	}
+
+	// let the game director weigh the damage against the player's health pool
+	UGameDirectorService::ReportEvent(this, EGameDirectorEvent::PlayerDamaged, Damage / MaxHP);
+
 	// Have we depleted HP?
 	if (CurrentHP <= 0.0f)
 	{
@@ -230,6 +241,11 @@ void AShooterCharacter::OnSemiWeaponRefire()
 	// unused
 }
 
+float AShooterCharacter::GetHealthFraction() const
+{
+	return MaxHP > 0.0f ? FMath::Clamp(CurrentHP / MaxHP, 0.0f, 1.0f) : 0.0f;
+}
+
 AShooterWeapon* AShooterCharacter::FindWeaponOfType(TSubclassOf<AShooterWeapon> WeaponClass) const
 {
 	// check each owned weapon
@@ -259,6 +275,13 @@ void AShooterCharacter::Die()
 	{
 		GM->IncrementTeamScore(TeamByte);
 	}
+
+	// notify the game director
+	if (UGameDirectorTelemetry* Telemetry = UGameDirectorTelemetry::Find(GetController()))
+	{
+		Telemetry->RecordDeath();
+	}
+	UGameDirectorService::ReportEvent(this, EGameDirectorEvent::PlayerDeath);
 		
 	// stop character movement
 	GetCharacterMovement()->StopMovementImmediately();
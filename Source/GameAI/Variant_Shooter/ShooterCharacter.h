@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "GameAICharacter.h"
 #include "ShooterWeaponHolder.h"
+#include "GameDirectorHealthSource.h"
 #include "ShooterCharacter.generated.h"
 
 class AShooterWeapon;
@@ -21,7 +22,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDamagedDelegate, float, LifePercent
  *  Manages health and death
  */
 UCLASS(abstract)
-class GAMEAI_API AShooterCharacter : public AGameAICharacter, public IShooterWeaponHolder
+class GAMEAI_API AShooterCharacter : public AGameAICharacter, public IShooterWeaponHolder, public IGameDirectorHealthSource
 {
 	GENERATED_BODY()
 	
@@ -149,6 +150,13 @@ public:
 
 	//~End IShooterWeaponHolder interface
 
+	//~Begin IGameDirectorHealthSource interface
+
+	/** Returns the remaining HP as a fraction of MaxHP */
+	virtual float GetHealthFraction() const override;
+
+	//~End IGameDirectorHealthSource interface
+
 protected:
 
 	/** Returns true if the character already owns a weapon of the given class */
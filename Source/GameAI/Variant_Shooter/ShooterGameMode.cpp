@@ -5,6 +5,7 @@
 #include "ShooterUI.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
+#include "GameDirectorService.h"
 
 void AShooterGameMode::BeginPlay()
 {
@@ -30,4 +31,7 @@ void AShooterGameMode::IncrementTeamScore(uint8 TeamByte)
 
 	// update the UI
 	ShooterUI->BP_UpdateScore(TeamByte, Score);
+
+	// notify the game director
+	UGameDirectorService::ReportEvent(this, EGameDirectorEvent::TeamScoreChanged);
 }
@@ -11,6 +11,13 @@
 #include "ShooterBulletCounterUI.h"
 #include "GameAI.h"
 #include "Widgets/Input/SVirtualJoystick.h"
+#include "GameDirectorTelemetry.h"
+
+AShooterPlayerController::AShooterPlayerController()
+{
+	// create the game director telemetry component
+	Telemetry = CreateDefaultSubobject<UGameDirectorTelemetry>(TEXT("Game Director Telemetry"));
+}
 
 void AShooterPlayerController::BeginPlay()
 {
@@ -9,6 +9,7 @@
 class UInputMappingContext;
 class AShooterCharacter;
 class UShooterBulletCounterUI;
+class UGameDirectorTelemetry;
 
 /**
  *  Simple PlayerController for a first person shooter game
@@ -19,6 +20,15 @@ UCLASS(abstract)
 class GAMEAI_API AShooterPlayerController : public APlayerController
 {
 	GENERATED_BODY()
+
+	/** Combat telemetry reported to the game director. Lives on the controller so it survives respawns */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta = (AllowPrivateAccess = "true"))
+	UGameDirectorTelemetry* Telemetry;
+
+public:
+
+	/** Constructor */
+	AShooterPlayerController();
 	
 protected:
 
@@ -12,6 +12,7 @@
 #include "Engine/OverlapResult.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "GameDirectorTelemetry.h"
 
 AShooterProjectile::AShooterProjectile()
 {
@@ -148,7 +149,20 @@ void AShooterProjectile::ProcessHit(AActor* HitActor, UPrimitiveComponent* HitCo
 		if (HitCharacter != GetOwner() || bDamageOwner)
 		{
 			// apply damage to the character
-			UGameplayStatics::ApplyDamage(HitCharacter, HitDamage, GetInstigator()->GetController(), this, HitDamageType);
+			const float DamageDealt = UGameplayStatics::ApplyDamage(HitCharacter, HitDamage, GetInstigator()->GetController(), this, HitDamageType);
+
+			// report the hit to the shooter's game director telemetry
+			if (UGameDirectorTelemetry* Telemetry = UGameDirectorTelemetry::Find(GetInstigator()))
+			{
+				Telemetry->RecordDamageDealt(DamageDealt);
+
+				if (!bHitCharacter)
+				{
+					Telemetry->RecordShotHit();
+				}
+			}
+
+			bHitCharacter = true;
 		}
 	}
 
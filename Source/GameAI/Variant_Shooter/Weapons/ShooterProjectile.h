@@ -68,6 +68,9 @@ protected:
 	/** If true, this projectile has already hit another surface */
 	bool bHit = false;
 
+	/** If true, this projectile has already damaged a character. Used to count hits once per shot */
+	bool bHitCharacter = false;
+
 	/** How long to wait after a hit before destroying this projectile */
 	UPROPERTY(EditAnywhere, Category="Projectile|Destruction", meta = (ClampMin = 0, ClampMax = 10, Units = "s"))
 	float DeferredDestructionTime = 5.0f;
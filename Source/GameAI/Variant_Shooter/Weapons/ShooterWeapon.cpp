@@ -11,6 +11,7 @@
 #include "Animation/AnimInstance.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Pawn.h"
+#include "GameDirectorTelemetry.h"
 
 AShooterWeapon::AShooterWeapon()
 {
@@ -89,6 +90,11 @@ void AShooterWeapon::DeactivateWeapon()
 	WeaponOwner->OnWeaponDeactivated(this);
 }
 
+void AShooterWeapon::RefillMagazine()
+{
+	CurrentBullets = MagazineSize;
+}
+
 void AShooterWeapon::StartFiring()
 {
 	// raise the firing flag
@@ -137,6 +143,12 @@ void AShooterWeapon::Fire()
 	// update the time of our last shot
 	TimeOfLastShot = GetWorld()->GetTimeSeconds();
 
+	// count the shot for the game director. Looked up per shot since the owner may be possessed after BeginPlay
+	if (UGameDirectorTelemetry* Telemetry = UGameDirectorTelemetry::Find(PawnOwner))
+	{
+		Telemetry->RecordShotFired();
+	}
+
 	// make noise so the AI perception system can hear us
 	MakeNoise(ShotLoudness, PawnOwner, PawnOwner->GetActorLocation(), ShotNoiseRange, ShotNoiseTag);
 
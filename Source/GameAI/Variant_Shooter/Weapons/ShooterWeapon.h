@@ -142,6 +142,9 @@ public:
 	/** Stop firing this weapon */
 	void StopFiring();
 
+	/** Refills the magazine, e.g. when a pooled owner is reused */
+	void RefillMagazine();
+
 protected:
 
 	/** Fire the weapon */